@@ -0,0 +1,107 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace bench {
+    /* 0-based edges of a synthetic graph, count of vertexes is 1 + max vertex */
+    using edges_t = std::vector<std::pair<uint32_t, uint32_t>>;
+
+    enum class generator_t { erdos_renyi, grid, rmat, path };
+
+    inline std::string_view generator_name(generator_t generator) {
+        switch (generator) {
+            case generator_t::erdos_renyi: return "erdos_renyi";
+            case generator_t::grid:        return "grid";
+            case generator_t::rmat:        return "rmat";
+            case generator_t::path:        return "path";
+        }
+        return "unknown";
+    }
+
+    /* G(n, m) with average degree 8, so the giant component covers almost all vertexes */
+    inline edges_t generate_erdos_renyi(size_t count_edges, unsigned seed) {
+        std::mt19937_64 gen{seed};
+        std::uniform_int_distribution<uint32_t> vertex(0, std::max<size_t>(count_edges / 4, 2) - 1);
+
+        edges_t edges(count_edges);
+        for (auto& edge : edges)
+            edge = {vertex(gen), vertex(gen)};
+        return edges;
+    }
+
+    /* side x side grid, neighbours differ in one coordinate, so it is bipartite */
+    inline edges_t generate_grid(size_t count_edges) {
+        size_t side = std::max<size_t>(std::sqrt(count_edges / 2.0), 2);
+
+        edges_t edges;
+        edges.reserve(2 * side * (side - 1));
+        for (size_t row = 0; row < side; ++row) {
+            for (size_t col = 0; col < side; ++col) {
+                uint32_t v = static_cast<uint32_t>(row * side + col);
+                if (col + 1 < side)
+                    edges.emplace_back(v, v + 1);
+                if (row + 1 < side)
+                    edges.emplace_back(v, static_cast<uint32_t>(v + side));
+            }
+        }
+        return edges;
+    }
+
+    /* R-MAT (Chakrabarti et al.) with Graph500 quadrant probabilities, power-law degrees */
+    inline edges_t generate_rmat(size_t count_edges, unsigned seed) {
+        constexpr double A = 0.57, B = 0.19, C = 0.19;
+        size_t scale = std::max<size_t>(std::ceil(std::log2(std::max<size_t>(count_edges / 8, 2))), 1);
+
+        std::mt19937_64 gen{seed};
+        std::uniform_real_distribution<double> quadrant(0, 1);
+
+        edges_t edges(count_edges);
+        for (auto& [v1, v2] : edges) {
+            v1 = v2 = 0;
+            for (size_t bit = 0; bit < scale; ++bit) {
+                double p = quadrant(gen);
+                v1 = (v1 << 1) | (p >= A + B);
+                v2 = (v2 << 1) | ((p >= A && p < A + B) || p >= A + B + C);
+            }
+        }
+        return edges;
+    }
+
+    /* one path, depth of traversals is count_edges */
+    inline edges_t generate_path(size_t count_edges) {
+        edges_t edges(count_edges);
+        for (size_t v = 0; v < count_edges; ++v)
+            edges[v] = {static_cast<uint32_t>(v), static_cast<uint32_t>(v + 1)};
+        return edges;
+    }
+
+    inline edges_t generate(generator_t generator, size_t count_edges, unsigned seed = 1) {
+        switch (generator) {
+            case generator_t::erdos_renyi: return generate_erdos_renyi(count_edges, seed);
+            case generator_t::grid:        return generate_grid(count_edges);
+            case generator_t::rmat:        return generate_rmat(count_edges, seed);
+            case generator_t::path:        return generate_path(count_edges);
+        }
+        return {};
+    }
+
+    /* the input format of graph_t::read: "v1 -- v2, weight" with 1-based vertexes */
+    inline std::string to_input(const edges_t& edges) {
+        std::string input;
+        input.reserve(edges.size() * 24);
+        for (auto [v1, v2] : edges) {
+            input += std::to_string(v1 + 1);
+            input += " -- ";
+            input += std::to_string(v2 + 1);
+            input += ", 1\n";
+        }
+        return input;
+    }
+}
\ No newline at end of file
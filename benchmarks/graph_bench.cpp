@@ -0,0 +1,223 @@
+#include "Graph/graph.hpp"
+#include "Graph/components.hpp"
+#include "generators.hpp"
+
+#include <benchmark/benchmark.h>
+#include <charconv>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+    using graph_type = graph::graph_t<std::monostate, int, uint32_t>;
+    using index_t    = graph_type::index_t;
+
+    constexpr size_t MIN_EDGES = 10'000;
+    constexpr size_t MAX_EDGES = 100'000'000;
+
+    struct workload_t final {
+        bench::generator_t generator;
+        size_t count_edges;
+        std::string input;
+        graph_type graph;
+    };
+
+    /* benchmarks are registered grouped by workload, so only the last one is kept in memory */
+    const workload_t& get_workload(bench::generator_t generator, size_t count_edges) {
+        static std::unique_ptr<workload_t> workload;
+        if (workload && workload->generator == generator && workload->count_edges == count_edges)
+            return *workload;
+
+        workload.reset();
+        workload = std::make_unique<workload_t>(generator, count_edges);
+        workload->input = bench::to_input(bench::generate(generator, count_edges));
+        workload->graph.read(workload->input, count_edges, 1);
+        return *workload;
+    }
+
+    /* VmHWM of the process, reset by clear_refs before every benchmark, so it is the peak
+       of the benchmark itself with the workload it runs on */
+    void reset_peak_rss() {
+        std::ofstream clear_refs{"/proc/self/clear_refs"};
+        clear_refs << "5";
+    }
+
+    double get_peak_rss_mib() {
+        std::ifstream status{"/proc/self/status"};
+        for (std::string line; std::getline(status, line);)
+            if (line.starts_with("VmHWM:"))
+                return std::stod(line.substr(6)) / 1024;
+        return 0;
+    }
+
+    void set_counters(benchmark::State& state, size_t count_edges) {
+        state.counters["edges/s"] = benchmark::Counter(static_cast<double>(count_edges),
+                                                       benchmark::Counter::kIsIterationInvariantRate);
+        state.counters["peak_rss_MiB"] = get_peak_rss_mib();
+    }
+
+    void bm_parse(benchmark::State& state, const workload_t& workload) {
+        for (auto _ : state) {
+            size_t count_edges = 0;
+            graph::for_each_edge<int>(std::string_view{workload.input}, [&](const auto&) { ++count_edges; });
+            benchmark::DoNotOptimize(count_edges);
+        }
+        set_counters(state, workload.graph.count_edges());
+    }
+
+    /* edges are parsed once before the loop, only graph_t construction is timed */
+    void bm_create(benchmark::State& state, const workload_t& workload) {
+        std::vector<graph::edge_parser_t<int>::edge_t> edges;
+        edges.reserve(workload.count_edges);
+        graph::for_each_edge<int>(std::string_view{workload.input}, [&](const auto& edge) { edges.push_back(edge); });
+
+        for (auto _ : state) {
+            graph_type graph;
+            graph.assign(edges);
+            benchmark::DoNotOptimize(graph.count_edges());
+        }
+        set_counters(state, workload.graph.count_edges());
+    }
+
+    /* parse and create together, as graph_t::read runs them */
+    void bm_read(benchmark::State& state, const workload_t& workload) {
+        for (auto _ : state) {
+            graph_type graph;
+            graph.read(workload.input, workload.count_edges, 1);
+            benchmark::DoNotOptimize(graph.count_edges());
+        }
+        set_counters(state, workload.graph.count_edges());
+    }
+
+    void bm_bfs(benchmark::State& state, const workload_t& workload) {
+        const auto& graph = workload.graph;
+        for (auto _ : state) {
+            size_t count_visited = 0;
+            graph::do_bfs(graph, {graph, 0}, [&](size_t) { ++count_visited; });
+            benchmark::DoNotOptimize(count_visited);
+        }
+        set_counters(state, graph.count_edges());
+    }
+
+    void bm_dfs(benchmark::State& state, const workload_t& workload) {
+        const auto& graph = workload.graph;
+        for (auto _ : state) {
+            size_t count_visited = 0;
+            graph::do_dfs(graph, {graph, 0}, [&](size_t) { ++count_visited; });
+            benchmark::DoNotOptimize(count_visited);
+        }
+        set_counters(state, graph.count_edges());
+    }
+
+    void bm_bipartite(benchmark::State& state, const workload_t& workload) {
+        for (auto _ : state) {
+            auto result = graph::get_bipartite(workload.graph);
+            benchmark::DoNotOptimize(result.is_bipartite);
+        }
+        set_counters(state, workload.graph.count_edges());
+    }
+
+    void bm_components(benchmark::State& state, const workload_t& workload) {
+        for (auto _ : state) {
+            auto result = graph::get_connected_components(workload.graph);
+            benchmark::DoNotOptimize(result.count());
+        }
+        set_counters(state, workload.graph.count_edges());
+    }
+
+    void bm_parallel_components(benchmark::State& state, const workload_t& workload) {
+        for (auto _ : state) {
+            auto result = graph::get_parallel_connected_components(workload.graph, std::max(graph::default_count_threads(), 2U));
+            benchmark::DoNotOptimize(result.count());
+        }
+        set_counters(state, workload.graph.count_edges());
+    }
+
+    /* cycle through the two last vertexes of BFS from 0, the longest walks to the root */
+    void bm_odd_cycle(benchmark::State& state, const workload_t& workload) {
+        const auto& graph = workload.graph;
+        size_t count_verts = graph.count_verts();
+        std::vector<index_t> parents(count_verts, static_cast<index_t>(count_verts + 1));
+        std::vector<index_t> order;
+        for (auto step : graph::bfs_range(graph, {graph, 0})) {
+            if (step.vertex != step.parent)
+                parents[step.vertex] = step.parent;
+            order.push_back(step.vertex);
+        }
+        size_t u = order.back(), v = order[order.size() > 1 ? order.size() - 2 : 0];
+
+        size_t cycle_size = 0;
+        for (auto _ : state) {
+            auto cycle = graph::get_odd_cycle(u, v, count_verts, parents);
+            cycle_size = cycle.size();
+            benchmark::DoNotOptimize(cycle.data());
+        }
+        state.counters["cycle_verts"] = static_cast<double>(cycle_size);
+        state.counters["verts/s"] = benchmark::Counter(static_cast<double>(cycle_size),
+                                                       benchmark::Counter::kIsIterationInvariantRate);
+        state.counters["peak_rss_MiB"] = get_peak_rss_mib();
+    }
+
+    /* --max_edges=<n> limits the largest workload, 10^8 edges need several GiB */
+    size_t parse_max_edges(int& argc, char* argv[]) {
+        constexpr std::string_view FLAG = "--max_edges=";
+        size_t max_edges = 10'000'000;
+        for (int i = 1; i < argc; ++i) {
+            std::string_view arg = argv[i];
+            if (!arg.starts_with(FLAG))
+                continue;
+
+            arg.remove_prefix(FLAG.size());
+            auto [end, error] = std::from_chars(arg.data(), arg.data() + arg.size(), max_edges);
+            if (error != std::errc{} || end != arg.data() + arg.size())
+                throw graph::error_t{"Invalid argument: " + std::string{argv[i]}};
+
+            std::copy(argv + i + 1, argv + argc, argv + i);
+            --argc;
+            break;
+        }
+        return std::min(max_edges, MAX_EDGES);
+    }
+
+    void register_benchmarks(size_t max_edges) {
+        using phase_t = void (*)(benchmark::State&, const workload_t&);
+        const std::pair<std::string_view, phase_t> phases[] = {
+            {"parse", bm_parse}, {"create", bm_create}, {"read", bm_read}, {"do_bfs", bm_bfs}, {"do_dfs", bm_dfs},
+            {"get_bipartite", bm_bipartite}, {"get_odd_cycle", bm_odd_cycle},
+            {"get_connected_components", bm_components}, {"get_parallel_connected_components", bm_parallel_components}
+        };
+        const bench::generator_t generators[] = {
+            bench::generator_t::erdos_renyi, bench::generator_t::grid,
+            bench::generator_t::rmat,        bench::generator_t::path
+        };
+
+        for (auto generator : generators) {
+            for (size_t count_edges = MIN_EDGES; count_edges <= max_edges; count_edges *= 10) {
+                for (auto [phase_name, phase] : phases) {
+                    std::string name = std::string{phase_name} + "/" + std::string{bench::generator_name(generator)} +
+                                       "/" + std::to_string(count_edges);
+                    benchmark::RegisterBenchmark(name.c_str(), [=](benchmark::State& state) {
+                        const workload_t& workload = get_workload(generator, count_edges);
+                        reset_peak_rss();
+                        phase(state, workload);
+                    })->Unit(benchmark::kMillisecond);
+                }
+            }
+        }
+    }
+}
+
+int main(int argc, char* argv[]) try {
+    register_benchmarks(parse_max_edges(argc, argv));
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv))
+        return 1;
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+} catch (const graph::error_t& error) {
+    std::cout << error.what() << '\n';
+    return 1;
+}
\ No newline at end of file
@@ -16,12 +16,12 @@ class graphRecipe(ConanFile):
 
     # Binary configuration
     settings = "os", "compiler", "build_type", "arch"
-    options = {"shared": [True, False], "fPIC": [True, False]}
-    default_options = {"shared": False, "fPIC": True}
+    options = {"shared": [True, False], "fPIC": [True, False], "with_benchmarks": [True, False]}
+    default_options = {"shared": False, "fPIC": True, "with_benchmarks": False}
     test_requires = "gtest/1.15.0"
 
     # Sources are located in the same place as this recipe, copy them to the recipe
-    exports_sources = "CMakeLists.txt", "src/*", "include/*", "tests/*"
+    exports_sources = "CMakeLists.txt", "src/*", "include/*", "tests/*", "benchmarks/*"
 
     def configure(self):
         if self.settings.compiler == "msvc":
@@ -31,6 +31,13 @@ class graphRecipe(ConanFile):
         else:
             self.settings.compiler.cppstd = "20"  # Default to "20" for other compilers
 
+    def build_requirements(self):
+        if self.options.with_benchmarks:
+            self.test_requires("benchmark/1.9.0")
+
+    def package_id(self):
+        del self.info.options.with_benchmarks
+
     def config_options(self):
         if self.settings.os == "Windows":
             del self.options.fPIC
@@ -42,6 +49,7 @@ class graphRecipe(ConanFile):
         deps = CMakeDeps(self)
         deps.generate()
         tc = CMakeToolchain(self)
+        tc.cache_variables["ENABLE_BENCHMARKS"] = bool(self.options.with_benchmarks)
         tc.generate()
 
         # Delete CMakeUserPresets.json
@@ -63,4 +71,6 @@ class graphRecipe(ConanFile):
         self.cpp_info.set_property("cmake_file_name", "Graph")
         self.cpp_info.set_property("cmake_target_name", "Graph::Graph")
         self.cpp_info.libs = ["Graph"]
-        self.cpp_info.includedirs = ["include"]
\ No newline at end of file
+        self.cpp_info.includedirs = ["include"]
+        if self.settings.os in ["Linux", "FreeBSD"]:
+            self.cpp_info.system_libs = ["pthread"]
\ No newline at end of file
@@ -11,6 +11,11 @@ namespace graph {
         error_t(std::string msg) : std::runtime_error(std::move(msg)) {}
     };
 
+    inline void check_vertex_indexes(long long v1, long long v2) {
+        if (v1 <= 0 || v2 <= 0)
+            throw error_t{"Invalid vertex index: <= 0"};
+    }
+
     template <typename T>
     concept not_monostate = !std::is_same_v<T, std::monostate>;
 
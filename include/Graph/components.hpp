@@ -0,0 +1,154 @@
+#pragma once
+
+#include "Graph/graph.hpp"
+#include "Graph/parallel.hpp"
+#include "Graph/stats.hpp"
+#include "Graph/union_find.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+namespace graph {
+    template <typename IndexT>
+    struct connected_components_result_t final {
+        /* components are numbered in order of their minimal vertex, in original ids */
+        std::vector<IndexT> labels;
+        std::vector<IndexT> sizes;
+
+        size_t count() const noexcept { return sizes.size(); }
+    };
+
+    /* BFS from every unlabeled vertex */
+    template <typename GraphT>
+    inline connected_components_result_t<typename GraphT::index_t> get_connected_components(const GraphT& graph) {
+        using index_t  = typename GraphT::index_t;
+        using result_t = connected_components_result_t<index_t>;
+        static constexpr index_t NO_LABEL = std::numeric_limits<index_t>::max();
+        GRAPH_STATS_TIMER("get_connected_components");
+
+        size_t count_verts = graph.count_verts();
+        result_t result{std::vector<index_t>(count_verts, NO_LABEL), {}};
+        std::vector<index_t> internal_labels(count_verts, NO_LABEL);
+        std::vector<index_t> queue;
+        queue.reserve(count_verts);
+
+        for (size_t v = 0; v < count_verts; ++v) {
+            size_t start = internal_id(graph, v);
+            if (internal_labels[start] != NO_LABEL)
+                continue;
+
+            index_t label = static_cast<index_t>(result.sizes.size());
+            internal_labels[start] = label;
+            queue.assign(1, static_cast<index_t>(start));
+            for (size_t head = 0; head < queue.size(); ++head) {
+                for (auto child : graph.get_range_children({graph, queue[head]})) {
+                    index_t next = child.index();
+                    if (internal_labels[next] == NO_LABEL) {
+                        internal_labels[next] = label;
+                        queue.push_back(next);
+                    }
+                }
+            }
+            result.sizes.push_back(static_cast<index_t>(queue.size()));
+        }
+        GRAPH_STATS_ADD(vertexes_visited, count_verts);
+
+        for (size_t v = 0; v < count_verts; ++v)
+            result.labels[v] = internal_labels[internal_id(graph, v)];
+        return result;
+    }
+
+    /* Afforest (Sutton et al.): the first NEIGHBOR_ROUNDS children of every vertex
+       are linked in concurrent union-find, the most frequent root of a sample is
+       the giant component, then only vertexes outside of it link the rest of
+       their children. Links from the giant side are found from the other end.
+       With one thread it is get_connected_components itself. */
+    template <typename GraphT>
+    inline connected_components_result_t<typename GraphT::index_t>
+    get_parallel_connected_components(const GraphT& graph, unsigned count_threads = default_count_threads()) {
+        using index_t  = typename GraphT::index_t;
+        using result_t = connected_components_result_t<index_t>;
+        static constexpr size_t  CHUNK_SIZE       = 1024;
+        static constexpr size_t  NEIGHBOR_ROUNDS  = 2;
+        static constexpr size_t  COUNT_SAMPLES    = 1024;
+        static constexpr index_t NO_LABEL         = std::numeric_limits<index_t>::max();
+
+        if (count_threads <= 1)
+            return get_connected_components(graph);
+        GRAPH_STATS_TIMER("get_parallel_connected_components");
+
+        size_t count_verts = graph.count_verts();
+        auto for_each_chunk = [&](auto&& func) {
+            std::atomic<size_t> next_chunk = 0;
+            run_parallel(count_threads, [&](unsigned) {
+                for (size_t begin = next_chunk.fetch_add(CHUNK_SIZE); begin < count_verts;
+                            begin = next_chunk.fetch_add(CHUNK_SIZE))
+                    func(begin, std::min(begin + CHUNK_SIZE, count_verts));
+            });
+        };
+
+        concurrent_union_find_t<index_t> components{count_verts};
+        for_each_chunk([&](size_t begin, size_t end) {
+            for (size_t v = begin; v < end; ++v) {
+                size_t round = 0;
+                for (auto child : graph.get_range_children({graph, v})) {
+                    if (round++ == NEIGHBOR_ROUNDS)
+                        break;
+                    components.unite(static_cast<index_t>(v), child.index());
+                }
+            }
+        });
+
+        index_t giant = NO_LABEL;
+        if (count_verts > 0) {
+            std::mt19937 gen{0};
+            std::uniform_int_distribution<size_t> vertex(0, count_verts - 1);
+            std::unordered_map<index_t, size_t> frequencies;
+            size_t max_frequency = 0;
+            for (size_t i = 0; i < COUNT_SAMPLES; ++i) {
+                index_t root = components.find(static_cast<index_t>(vertex(gen)));
+                if (++frequencies[root] > max_frequency) {
+                    max_frequency = frequencies[root];
+                    giant = root;
+                }
+            }
+        }
+
+        for_each_chunk([&](size_t begin, size_t end) {
+            for (size_t v = begin; v < end; ++v) {
+                if (components.find(static_cast<index_t>(v)) == giant)
+                    continue;
+
+                size_t round = 0;
+                for (auto child : graph.get_range_children({graph, v}))
+                    if (round++ >= NEIGHBOR_ROUNDS)
+                        components.unite(static_cast<index_t>(v), child.index());
+            }
+        });
+
+        /* roots are numbered in order of original ids, as get_connected_components does */
+        std::vector<index_t> roots(count_verts);
+        for_each_chunk([&](size_t begin, size_t end) {
+            for (size_t v = begin; v < end; ++v)
+                roots[v] = components.find(static_cast<index_t>(internal_id(graph, v)));
+        });
+        GRAPH_STATS_ADD(vertexes_visited, count_verts);
+
+        result_t result{std::vector<index_t>(count_verts), {}};
+        std::vector<index_t> root_labels(count_verts, NO_LABEL);
+        for (size_t v = 0; v < count_verts; ++v) {
+            index_t& label = root_labels[roots[v]];
+            if (label == NO_LABEL) {
+                label = static_cast<index_t>(result.sizes.size());
+                result.sizes.push_back(0);
+            }
+            result.labels[v] = label;
+            result.sizes[label]++;
+        }
+        return result;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,188 @@
+#pragma once
+
+#include "Graph/graph.hpp"
+
+namespace graph {
+    /* Immutable compressed sparse row copy of graph_t: children of vertex v are
+       neighbors_[offsets_[v] .. offsets_[v + 1]), so traversal reads them sequentially.
+       Arrays use the allocator of the source graph. */
+    template <typename VertexT = std::monostate, typename EdgeT = std::monostate, typename IndexT = size_t,
+              typename AllocatorT = std::allocator<std::byte>>
+    class csr_graph_t final {
+    public:
+        using index_t        = IndexT;
+        using allocator_type = AllocatorT;
+
+    private:
+        template <typename T>
+        using vector_t = std::vector<T, typename std::allocator_traits<AllocatorT>::template rebind_alloc<T>>;
+
+    private:
+        size_t count_verts_ = 0;
+        size_t count_edges_ = 0;
+
+        vector_t<VertexT> v_data_;
+        vector_t<EdgeT>   arc_data_;
+        vector_t<IndexT>  offsets_;
+        vector_t<IndexT>  neighbors_;
+
+        /* relabeling of the source graph, both empty if it was not relabeled */
+        vector_t<IndexT>  original_ids_;
+        vector_t<IndexT>  internal_ids_;
+
+    private:
+        class iterator_data_t final {
+            const VertexT* vertex_;
+            const EdgeT*   edge_;
+            IndexT         index_;
+
+        public:
+            iterator_data_t(const VertexT& vertex, const EdgeT& edge, IndexT index)
+            : vertex_(&vertex), edge_(&edge), index_(index) {}
+
+            const VertexT& vertex() const { return *vertex_; }
+            const EdgeT&   edge()   const { return *edge_; }
+
+            IndexT index() const noexcept { return index_; }
+        };
+
+        class internal_iterator_t final {
+            struct arrow_proxy final {
+                iterator_data_t reference;
+
+            public:
+                arrow_proxy(const iterator_data_t& reference_) : reference(reference_) {}
+                const iterator_data_t *operator->() const { return &reference; }
+            };
+
+        private:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type        = iterator_data_t;
+            using reference         = iterator_data_t;
+            using pointer           = arrow_proxy;
+            using difference_type   = std::ptrdiff_t;
+
+            const csr_graph_t* graph_;
+            IndexT index_;
+            IndexT count_verts_;
+
+        public:
+            internal_iterator_t(const csr_graph_t& graph, size_t index)
+            : graph_(&graph), index_(static_cast<IndexT>(index)),
+              count_verts_(static_cast<IndexT>(graph.count_verts())) {}
+
+            IndexT index() const noexcept { return index_; }
+
+            reference operator*() const {
+                IndexT arc = index_ - count_verts_;
+                IndexT vertex = graph_->neighbors_[arc];
+
+                return {graph_->v_data_[vertex], graph_->arc_data_[arc], vertex};
+            }
+
+            pointer operator->() const noexcept { return **this; }
+
+            bool operator==(const internal_iterator_t& other) const noexcept {
+                return ((graph_ == other.graph_) && (index_ == other.index_));
+            }
+
+            bool operator!=(const internal_iterator_t& other) const noexcept {
+                return !(*this == other);
+            }
+
+            internal_iterator_t& operator++() noexcept {
+                ++index_;
+                return *this;
+            }
+        };
+
+    public:
+        using const_iterator_t = internal_iterator_t;
+        using       iterator_t = internal_iterator_t;
+
+    private:
+        class range_children_t final {
+            const csr_graph_t* graph_;
+            IndexT vertex_;
+
+        public:
+            range_children_t(const csr_graph_t& graph, IndexT vertex)
+            : graph_(&graph), vertex_(vertex) {}
+
+            const_iterator_t begin() const {
+                return {*graph_, graph_->count_verts_ + graph_->offsets_[vertex_]};
+            }
+
+            const_iterator_t end() const {
+                return {*graph_, graph_->count_verts_ + graph_->offsets_[vertex_ + 1]};
+            }
+        };
+
+    public:
+        csr_graph_t() : offsets_(1, 0) {}
+
+        explicit csr_graph_t(const graph_t<VertexT, EdgeT, IndexT, AllocatorT>& graph)
+        : count_verts_(graph.count_verts()), count_edges_(graph.count_edges()),
+          v_data_(count_verts_, graph.get_allocator()), arc_data_(2 * count_edges_, graph.get_allocator()),
+          offsets_(count_verts_ + 1, 0, graph.get_allocator()), neighbors_(2 * count_edges_, graph.get_allocator()),
+          original_ids_(graph.get_allocator()), internal_ids_(graph.get_allocator()) {
+            for (auto v : std::views::iota(0UL, count_verts_))
+                v_data_[v] = graph.get_vertex_info({graph, v});
+
+            for (auto v : std::views::iota(0UL, count_verts_))
+                for ([[maybe_unused]] auto child : graph.get_range_children({graph, v}))
+                    offsets_[v + 1]++;
+            std::partial_sum(offsets_.begin(), offsets_.end(), offsets_.begin());
+
+            for (auto v : std::views::iota(0UL, count_verts_)) {
+                IndexT arc = offsets_[v];
+                for (auto child : graph.get_range_children({graph, v})) {
+                    neighbors_[arc] = child.index();
+                    arc_data_ [arc] = child.edge();
+                    arc++;
+                }
+            }
+
+            if (graph.is_relabeled()) {
+                original_ids_.resize(count_verts_);
+                internal_ids_.resize(count_verts_);
+                for (auto v : std::views::iota(0UL, count_verts_)) {
+                    original_ids_[v] = static_cast<IndexT>(graph.original_id(v));
+                    internal_ids_[v] = static_cast<IndexT>(graph.internal_id(v));
+                }
+            }
+        }
+
+        allocator_type get_allocator() const { return allocator_type(neighbors_.get_allocator()); }
+
+        const VertexT& get_vertex_info(const_iterator_t iterator) const {
+            size_t index = iterator.index();
+            if (index >= count_verts_)
+                throw error_t{"Invalid vertex index: " + std::to_string(index)};
+            return v_data_[index];
+        }
+
+        range_children_t get_range_children(const_iterator_t iterator) const {
+            return range_children_t{*this, iterator.index()};
+        }
+
+        bool is_relabeled() const noexcept { return !original_ids_.empty(); }
+
+        size_t original_id(size_t vertex) const noexcept {
+            return is_relabeled() ? original_ids_[vertex] : vertex;
+        }
+
+        size_t internal_id(size_t vertex) const noexcept {
+            return is_relabeled() ? internal_ids_[vertex] : vertex;
+        }
+
+        size_t count_verts() const noexcept { return count_verts_; }
+        size_t count_edges() const noexcept { return count_edges_; }
+    };
+
+    template <typename VertexT, typename EdgeT, typename IndexT, typename AllocatorT>
+    inline csr_graph_t<VertexT, EdgeT, IndexT, AllocatorT>
+    to_csr(const graph_t<VertexT, EdgeT, IndexT, AllocatorT>& graph) {
+        return csr_graph_t<VertexT, EdgeT, IndexT, AllocatorT>{graph};
+    }
+}
\ No newline at end of file
@@ -0,0 +1,392 @@
+#pragma once
+
+#include "Graph/graph.hpp"
+#include "Graph/parser.hpp"
+#include "Graph/snapshot.hpp"
+#include "Graph/stats.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fcntl.h>
+#include <fstream>
+#include <memory>
+#include <numeric>
+#include <span>
+#include <string>
+#include <string_view>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <unistd.h>
+#include <vector>
+
+namespace graph {
+    /* Binary layout: header, then offsets, neighbors and arc data arrays of CSR,
+       each one starts at a page boundary, so madvise() covers exactly the adjacency */
+    struct external_header_t final {
+        static constexpr std::array<char, 8> MAGIC      = {'G', 'R', 'A', 'P', 'H', 'E', 'X', 'T'};
+        static constexpr uint32_t            VERSION    = 1;
+        static constexpr uint32_t            ENDIAN_TAG = 0x01020304;
+        static constexpr size_t              PAGE_SIZE  = 4096;
+
+        std::array<char, 8> magic;
+        uint32_t version;
+        uint32_t endian_tag;
+        uint32_t edge_size;
+        uint32_t index_size;
+        uint64_t count_verts;
+        uint64_t count_edges;
+        uint64_t offsets_offset;
+        uint64_t neighbors_offset;
+        uint64_t arc_data_offset;
+        uint64_t file_size;
+
+        static uint64_t align(uint64_t offset) noexcept {
+            return (offset + PAGE_SIZE - 1) / PAGE_SIZE * PAGE_SIZE;
+        }
+
+        template <typename EdgeT, typename IndexT>
+        static external_header_t create(size_t count_verts, size_t count_edges) {
+            constexpr size_t ARC_DATA_SIZE = not_monostate<EdgeT> ? sizeof(EdgeT) : 0;
+
+            external_header_t header{};
+            header.magic       = MAGIC;
+            header.version     = VERSION;
+            header.endian_tag  = ENDIAN_TAG;
+            header.edge_size   = ARC_DATA_SIZE;
+            header.index_size  = sizeof(IndexT);
+            header.count_verts = count_verts;
+            header.count_edges = count_edges;
+
+            header.offsets_offset   = align(sizeof(external_header_t));
+            header.neighbors_offset = align(header.offsets_offset   + (count_verts + 1) * sizeof(IndexT));
+            header.arc_data_offset  = align(header.neighbors_offset + 2 * count_edges * sizeof(IndexT));
+            header.file_size        = header.arc_data_offset + 2 * count_edges * ARC_DATA_SIZE;
+            return header;
+        }
+
+        template <typename EdgeT, typename IndexT>
+        void validate(size_t real_file_size) const {
+            if (magic != MAGIC)
+                throw error_t{"Invalid external graph: wrong magic"};
+            if (version != VERSION)
+                throw error_t{"Invalid external graph: unsupported version: " + std::to_string(version)};
+            if (endian_tag != ENDIAN_TAG)
+                throw error_t{"Invalid external graph: byte order differs from host"};
+
+            if (edge_size != (not_monostate<EdgeT> ? sizeof(EdgeT) : 0) || index_size != sizeof(IndexT))
+                throw error_t{"Invalid external graph: edge or index type size mismatch"};
+            /* counts bounded by the file first, so offsets below do not overflow */
+            if (count_verts >= real_file_size / sizeof(IndexT) || count_edges > real_file_size / sizeof(IndexT))
+                throw error_t{"Invalid external graph: corrupted layout"};
+
+            auto expected = create<EdgeT, IndexT>(count_verts, count_edges);
+            if (offsets_offset   != expected.offsets_offset   || neighbors_offset != expected.neighbors_offset ||
+                arc_data_offset  != expected.arc_data_offset  || file_size        != expected.file_size        ||
+                real_file_size   <  file_size)
+                throw error_t{"Invalid external graph: corrupted layout"};
+        }
+    };
+
+    namespace details {
+        /* shared writable mapping of a new file of given size, pages go to disk on unmap */
+        class mapped_output_t final {
+            void*  data_ = nullptr;
+            size_t size_ = 0;
+
+        public:
+            mapped_output_t(const std::filesystem::path& path, size_t size) : size_(size) {
+                int fd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+                if (fd < 0)
+                    throw error_t{"Can not open external graph file: " + path.string()};
+
+                if (ftruncate(fd, static_cast<off_t>(size)) == 0)
+                    data_ = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+                close(fd);
+                if (data_ == nullptr || data_ == MAP_FAILED) {
+                    data_ = nullptr;
+                    throw error_t{"Can not map external graph file: " + path.string()};
+                }
+            }
+
+            mapped_output_t(const mapped_output_t&) = delete;
+            mapped_output_t& operator=(const mapped_output_t&) = delete;
+
+            ~mapped_output_t() { munmap(data_, size_); }
+
+            template <typename T>
+            T* get_array(uint64_t offset) const noexcept {
+                return reinterpret_cast<T*>(static_cast<char*>(data_) + offset);
+            }
+        };
+    }
+
+    /* Read I/O of the whole process: bytes fetched from storage (page cache hits
+       are free) and major page faults, a traversal is measured by the difference.
+       read_bytes is 0 where the kernel has no task I/O accounting. */
+    struct io_usage_t final {
+        uint64_t read_bytes   = 0;
+        uint64_t major_faults = 0;
+
+        io_usage_t operator-(const io_usage_t& other) const noexcept {
+            return {read_bytes - other.read_bytes, major_faults - other.major_faults};
+        }
+    };
+
+    inline io_usage_t get_io_usage() {
+        io_usage_t usage;
+        std::ifstream io{"/proc/self/io"};
+        for (std::string line; std::getline(io, line);)
+            if (line.starts_with("read_bytes:"))
+                usage.read_bytes = std::stoull(line.substr(11));
+
+        struct rusage resources;
+        if (getrusage(RUSAGE_SELF, &resources) == 0)
+            usage.major_faults = static_cast<uint64_t>(resources.ru_majflt);
+        return usage;
+    }
+
+    /* Builds the file of external_graph_t from "a -- b, w" input in two passes,
+       RAM holds only per-vertex degrees and positions, arcs are written in place
+       into the mapped file, whose pages the kernel evicts as needed */
+    template <typename EdgeT = std::monostate, typename IndexT = size_t>
+    inline void write_external_graph(std::string_view input, const std::filesystem::path& path) {
+        GRAPH_STATS_TIMER("write_external_graph");
+        std::vector<IndexT> offsets(1, 0);
+        size_t count_edges = 0;
+        /* the same rule as graph_t: the maximal index is reserved */
+        auto check_fits_index = [](size_t count_slots) {
+            if (count_slots >= std::numeric_limits<IndexT>::max())
+                throw error_t{"Invalid input: graph does not fit into index type"};
+        };
+
+        for_each_edge<EdgeT>(input, [&](const auto& edge) {
+            const auto& [v1, v2, _] = edge;
+            size_t max_vertex = std::max(v1, v2);
+            check_fits_index(max_vertex + 1);
+            if (max_vertex + 2 > offsets.size())
+                offsets.resize(max_vertex + 2, 0);
+            offsets[v1 + 1]++;
+            offsets[v2 + 1]++;
+            count_edges++;
+        });
+
+        /* even count of vertexes as in graph_t */
+        size_t count_verts = offsets.size() - 1;
+        if (count_verts % 2)
+            offsets.push_back(0);
+        count_verts += count_verts % 2;
+        check_fits_index(count_verts + 2 * count_edges);
+        std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+        auto header = external_header_t::create<EdgeT, IndexT>(count_verts, count_edges);
+        details::mapped_output_t output{path, header.file_size};
+        std::memcpy(output.get_array<external_header_t>(0), &header, sizeof(header));
+        std::memcpy(output.get_array<IndexT>(header.offsets_offset), offsets.data(), offsets.size() * sizeof(IndexT));
+
+        IndexT* neighbors = output.get_array<IndexT>(header.neighbors_offset);
+        [[maybe_unused]] EdgeT* arc_data = output.get_array<EdgeT>(header.arc_data_offset);
+        std::vector<IndexT>& positions = offsets;
+        for_each_edge<EdgeT>(input, [&](const auto& edge) {
+            const auto& [v1, v2, w] = edge;
+            for (auto [from, to] : {std::pair{v1, v2}, std::pair{v2, v1}}) {
+                IndexT arc = positions[from]++;
+                neighbors[arc] = static_cast<IndexT>(to);
+                if constexpr (not_monostate<EdgeT>)
+                    arc_data[arc] = w;
+            }
+        });
+    }
+
+    /* Semi-external CSR: offsets and vertex data are kept in RAM, neighbors and
+       arc data stay in the mapped file and are paged in by traversals. Has the same
+       const interface as graph_t, so traversals run on it unchanged. Children are
+       not counted, read I/O of a traversal is measured around it by get_io_usage(). */
+    template <typename VertexT = std::monostate, typename EdgeT = std::monostate, typename IndexT = size_t>
+    requires snapshotable<VertexT, EdgeT, IndexT>
+    class external_graph_t final {
+    public:
+        using index_t = IndexT;
+
+    private:
+        template <typename T>
+        using payload_vector_t = std::conditional_t<not_monostate<T>, std::vector<T>, details::empty_payload_t<T>>;
+
+    private:
+        std::unique_ptr<mapped_file_t> file_;
+
+        size_t count_verts_ = 0;
+        size_t count_edges_ = 0;
+
+        [[no_unique_address]] payload_vector_t<VertexT> v_data_;
+        std::vector<IndexT> offsets_;
+        std::span<const IndexT> neighbors_;
+        std::span<const EdgeT>  arc_data_;
+
+    private:
+        class iterator_data_t final {
+            [[no_unique_address]] details::payload_pointer_t<const VertexT, 0> vertex_;
+            [[no_unique_address]] details::payload_pointer_t<const EdgeT,   1> edge_;
+            IndexT index_;
+
+        public:
+            iterator_data_t(const VertexT& vertex, const EdgeT& edge, IndexT index)
+            : vertex_(vertex), edge_(edge), index_(index) {}
+
+            const VertexT& vertex() const { return *vertex_; }
+            const EdgeT&   edge()   const { return *edge_; }
+
+            IndexT index() const noexcept { return index_; }
+        };
+
+        class internal_iterator_t final {
+            struct arrow_proxy final {
+                iterator_data_t reference;
+
+            public:
+                arrow_proxy(const iterator_data_t& reference_) : reference(reference_) {}
+                const iterator_data_t *operator->() const { return &reference; }
+            };
+
+        private:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type        = iterator_data_t;
+            using reference         = iterator_data_t;
+            using pointer           = arrow_proxy;
+            using difference_type   = std::ptrdiff_t;
+
+            const external_graph_t* graph_;
+            IndexT index_;
+            IndexT count_verts_;
+
+        public:
+            internal_iterator_t(const external_graph_t& graph, size_t index)
+            : graph_(&graph), index_(static_cast<IndexT>(index)),
+              count_verts_(static_cast<IndexT>(graph.count_verts())) {}
+
+            IndexT index() const noexcept { return index_; }
+
+            reference operator*() const {
+                IndexT arc = index_ - count_verts_;
+                IndexT vertex = graph_->neighbors_[arc];
+
+                return {graph_->v_data_[vertex], graph_->get_arc_data(arc), vertex};
+            }
+
+            pointer operator->() const noexcept { return **this; }
+
+            bool operator==(const internal_iterator_t& other) const noexcept {
+                return ((graph_ == other.graph_) && (index_ == other.index_));
+            }
+
+            bool operator!=(const internal_iterator_t& other) const noexcept {
+                return !(*this == other);
+            }
+
+            internal_iterator_t& operator++() noexcept {
+                ++index_;
+                return *this;
+            }
+        };
+
+    public:
+        using const_iterator_t = internal_iterator_t;
+        using       iterator_t = internal_iterator_t;
+
+    private:
+        class range_children_t final {
+            const external_graph_t* graph_;
+            IndexT vertex_;
+
+        public:
+            range_children_t(const external_graph_t& graph, IndexT vertex)
+            : graph_(&graph), vertex_(vertex) {}
+
+            const_iterator_t begin() const {
+                return {*graph_, graph_->count_verts_ + graph_->offsets_[vertex_]};
+            }
+
+            const_iterator_t end() const {
+                return {*graph_, graph_->count_verts_ + graph_->offsets_[vertex_ + 1]};
+            }
+        };
+
+        const EdgeT& get_arc_data(IndexT arc) const noexcept {
+            if constexpr (not_monostate<EdgeT>)
+                return arc_data_[arc];
+            else
+                return details::empty_payload_t<EdgeT>{}[arc];
+        }
+
+        template <typename T>
+        std::span<const T> get_array(uint64_t offset, size_t size) const {
+            const char* base = file_->view().data() + offset;
+            return {reinterpret_cast<const T*>(base), size};
+        }
+
+    public:
+        external_graph_t() : offsets_(1, 0) {}
+
+        /* advice is for the adjacency: MADV_RANDOM for traversals of large graphs,
+           so page faults do not read ahead pages of unrelated vertexes.
+           Offsets are always checked, is_verified skips the sequential pass over
+           neighbors, for trusted files only */
+        explicit external_graph_t(const std::filesystem::path& path, int advice = MADV_RANDOM,
+                                  bool is_verified = false)
+        : file_(std::make_unique<mapped_file_t>(path, MADV_NORMAL)) {
+            std::string_view data = file_->view();
+            external_header_t header;
+            if (data.size() < sizeof(header))
+                throw error_t{"Invalid external graph: file is too small"};
+            std::memcpy(&header, data.data(), sizeof(header));
+            header.validate<EdgeT, IndexT>(data.size());
+
+            count_verts_ = header.count_verts;
+            count_edges_ = header.count_edges;
+
+            auto offsets = get_array<IndexT>(header.offsets_offset, count_verts_ + 1);
+            offsets_.assign(offsets.begin(), offsets.end());
+            if (offsets_.front() != 0 || offsets_.back() != 2 * count_edges_ || !std::ranges::is_sorted(offsets_))
+                throw error_t{"Invalid external graph: corrupted offsets"};
+            v_data_.resize(count_verts_);
+
+            neighbors_ = get_array<IndexT>(header.neighbors_offset, 2 * count_edges_);
+            if constexpr (not_monostate<EdgeT>)
+                arc_data_ = get_array<EdgeT>(header.arc_data_offset, 2 * count_edges_);
+
+            if (!is_verified) {
+                advise(MADV_SEQUENTIAL);
+                if (!std::ranges::all_of(neighbors_, [&](IndexT vertex) { return vertex < count_verts_; }))
+                    throw error_t{"Invalid external graph: neighbor out of range"};
+            }
+            advise(advice);
+        }
+
+        /* e.g. MADV_SEQUENTIAL before a pass over all vertexes in order,
+           MADV_DONTNEED to give the page cache back after a traversal */
+        void advise(int advice) const {
+            if (!file_)
+                return;
+            std::string_view data = file_->view();
+            size_t begin = reinterpret_cast<const char*>(neighbors_.data()) - data.data();
+            if (begin < data.size())
+                madvise(const_cast<char*>(data.data()) + begin, data.size() - begin, advice);
+        }
+
+        const VertexT& get_vertex_info(const_iterator_t iterator) const {
+            size_t index = iterator.index();
+            if (index >= count_verts_)
+                throw error_t{"Invalid vertex index: " + std::to_string(index)};
+            return v_data_[index];
+        }
+
+        range_children_t get_range_children(const_iterator_t iterator) const {
+            return range_children_t{*this, iterator.index()};
+        }
+
+        size_t count_verts() const noexcept { return count_verts_; }
+        size_t count_edges() const noexcept { return count_edges_; }
+    };
+}
\ No newline at end of file
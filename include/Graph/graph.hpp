@@ -1,33 +1,113 @@
 #pragma once
 
 #include "Graph/common.hpp"
+#include "Graph/parser.hpp"
+#include "Graph/snapshot.hpp"
+#include "Graph/stats.hpp"
+#include "Graph/traversal_range.hpp"
+#include "Graph/traversal_workspace.hpp"
 
 #include <algorithm>
+#include <cstddef>
 #include <functional>
 #include <iomanip>
 #include <iostream>
+#include <limits>
 #include <memory>
 #include <numeric>
-#include <queue>
 #include <ranges>
-#include <stack>
+#include <span>
 #include <utility>
 #include <vector>
 
 namespace graph {
-    template <typename VertexT = std::monostate, typename EdgeT = std::monostate>
+    namespace details {
+        /* Stands for the vector of std::monostate payloads: nothing is allocated or
+           written, every element is one shared empty object */
+        template <typename T>
+        class empty_payload_t final {
+            static inline T empty_;
+
+        public:
+            empty_payload_t() = default;
+
+            template <typename AllocatorT>
+            explicit empty_payload_t(const AllocatorT&) noexcept {}
+
+            template <typename AllocatorT>
+            empty_payload_t(size_t, const AllocatorT&) noexcept {}
+
+            template <typename AllocatorT>
+            empty_payload_t(const empty_payload_t&, const AllocatorT&) noexcept {}
+
+            T& operator[](size_t) const noexcept { return empty_; }
+
+            void clear()            noexcept {}
+            void reserve(size_t)    noexcept {}
+            void resize(size_t)     noexcept {}
+            void push_back(const T&) noexcept {}
+            void swap(empty_payload_t&) noexcept {}
+        };
+
+        /* pointer to a payload, for std::monostate it is empty and points to the shared one;
+           Id tells apart vertex and edge pointers, so both empty ones take no bytes */
+        template <typename T, size_t Id>
+        class payload_pointer_t final {
+            T* pointer_;
+
+        public:
+            payload_pointer_t(T& payload) noexcept : pointer_(&payload) {}
+            T& operator*() const noexcept { return *pointer_; }
+        };
+
+        template <typename T, size_t Id>
+        requires (!not_monostate<std::remove_const_t<T>>)
+        class payload_pointer_t<T, Id> final {
+        public:
+            payload_pointer_t(T&) noexcept {}
+            T& operator*() const noexcept { return empty_payload_t<std::remove_const_t<T>>{}[0]; }
+        };
+    }
+
+    /* All storage, build-time buffers included, comes from AllocatorT rebound to
+       the element types: std::pmr::polymorphic_allocator puts a graph into an arena */
+    template <typename VertexT = std::monostate, typename EdgeT = std::monostate, typename IndexT = size_t,
+              typename AllocatorT = std::allocator<std::byte>>
     class graph_t final {
+        static_assert(std::is_unsigned_v<IndexT>, "IndexT must be an unsigned integer type");
+
+    public:
+        using index_t        = IndexT;
+        using allocator_type = AllocatorT;
+
+    private:
         using edge_t = std::tuple<size_t, size_t, EdgeT>;
-        using building_list_of_edges_t = std::unordered_map<size_t, std::vector<std::pair<size_t, EdgeT>>>;
+
+        template <typename T>
+        using vector_t = std::vector<T, typename std::allocator_traits<AllocatorT>::template rebind_alloc<T>>;
+
+        /* std::monostate payloads take no memory, see details::empty_payload_t */
+        template <typename T>
+        using payload_vector_t = std::conditional_t<not_monostate<T>, vector_t<T>, details::empty_payload_t<T>>;
+
+        static constexpr size_t MAX_INDEX = std::numeric_limits<IndexT>::max();
+        static constexpr IndexT REMOVED   = std::numeric_limits<IndexT>::max();
 
     private:
         size_t count_verts_ = 0;
         size_t count_edges_ = 0;
+        size_t count_heads_ = 0;
+
+        vector_t<IndexT> free_edges_;
+
+        /* internal id -> original id and back, both empty until relabel() */
+        vector_t<IndexT> original_ids_;
+        vector_t<IndexT> internal_ids_;
 
-        std::vector<VertexT> v_data_;
-        std::vector<EdgeT>   e_data_;
-        std::vector<size_t>  edges_;
-        std::vector<size_t>  next_;
+        [[no_unique_address]] payload_vector_t<VertexT> v_data_;
+        [[no_unique_address]] payload_vector_t<EdgeT>   e_data_;
+        vector_t<IndexT>  edges_;
+        vector_t<IndexT>  next_;
 
     private:
         template <bool IsConstData>
@@ -36,21 +116,21 @@ namespace graph {
             using edge_value       = std::conditional_t<IsConstData, const EdgeT,    EdgeT>;
             using vertex_reference = vertex_value&;
             using edge_reference   = edge_value&;
-            using vertex_pointer   = vertex_value*;
-            using edge_pointer     = edge_value*;
+            using vertex_pointer   = details::payload_pointer_t<vertex_value, 0>;
+            using edge_pointer     = details::payload_pointer_t<edge_value,   1>;
 
-            vertex_pointer vertex_;
-            edge_pointer   edge_;
-            size_t         index_;
+            IndexT index_;
+            [[no_unique_address]] vertex_pointer vertex_;
+            [[no_unique_address]] edge_pointer   edge_;
 
         public:
-            iterator_data_t(vertex_value& vertex, edge_value& edge, size_t index)
-            : vertex_(&vertex), edge_(&edge), index_(index) {}
+            iterator_data_t(vertex_value& vertex, edge_value& edge, IndexT index)
+            : index_(index), vertex_(vertex), edge_(edge) {}
 
             vertex_reference vertex() const { return *vertex_; }
             edge_reference   edge()   const { return *edge_; }
 
-            size_t index() const noexcept { return index_;}
+            IndexT index() const noexcept { return index_;}
         };
 
         template <bool IsConst>
@@ -75,19 +155,23 @@ namespace graph {
             using difference_type   = std::ptrdiff_t;
 
             graph_type* graph_;
-            size_t index_;
-            size_t count_verts_;
+            IndexT index_;
+            IndexT count_heads_;
 
         public:
             internal_iterator_t(graph_type& graph, size_t index)
-            : graph_(&graph), index_(index), count_verts_(graph.count_verts()) {}
+            : graph_(&graph), index_(static_cast<IndexT>(index)),
+              count_heads_(static_cast<IndexT>(graph.count_heads_)) {}
 
-            size_t index() const noexcept { return index_; }
+            IndexT index() const noexcept { return index_; }
 
             reference operator*() const {
-                size_t e_index = index_ - count_verts_;
-                size_t vertex = graph_->edges_[e_index];
-                size_t edge = e_index ^ 1;
+                IndexT e_index = index_ - count_heads_;
+                IndexT edge = e_index ^ 1;
+
+                IndexT vertex = 0;
+                if constexpr (not_monostate<VertexT>)
+                    vertex = graph_->edges_[e_index];
 
                 return {graph_->v_data_[vertex],
                         graph_->e_data_[edge / 2],
@@ -122,10 +206,10 @@ namespace graph {
             using iterator_type = std::conditional_t<IsConst, const_iterator_t, iterator_t>;
 
             graph_type* graph_;
-            size_t start_index_;
+            IndexT start_index_;
 
         public:
-            internal_range_children_t(graph_type& graph, size_t start_index)
+            internal_range_children_t(graph_type& graph, IndexT start_index)
             : graph_(&graph), start_index_(start_index) {}
 
             iterator_type begin() const { return ++iterator_type{*graph_, start_index_}; }
@@ -136,11 +220,6 @@ namespace graph {
         using const_range_children_t = internal_range_children_t<true>;
 
     private:
-        static void check_vertex_indexes(int v1, int v2) {
-            if (v1 <= 0 || v2 <= 0)
-                throw error_t{"Invalid vertex index: <= 0"};
-        }
-
         void check_vertex_index(size_t index) const {
             if (index < count_verts_)
                 return;
@@ -152,80 +231,186 @@ namespace graph {
             throw error_t{oss.str()};
         }
 
-        static bool read_edge(std::istream& is, edge_t& edge) {
-            is >> std::ws;
-            if (is.eof())
-                return false;
+        static void check_fits_index(size_t count_slots) {
+            if (count_slots < MAX_INDEX)
+                return;
 
-            std::string dashes;
-            char comma;
-            int v1_, v2_;
-            is >> v1_ >> dashes >> v2_;
-            if (!is.good()) throw error_t{"Invalid edge indexes"};
-            if (dashes != "--")
-                throw error_t{"Invalid input: expected dashes between vertex indexes, read: " + dashes};
-            check_vertex_indexes(v1_, v2_);
-
-            EdgeT w_;
-            if constexpr(not_monostate<EdgeT> && has_input_operator<EdgeT>) {
-                is >> comma >> w_;
-                if (!is.good())   throw error_t{"Invalid edge info"};
-                if (comma != ',') throw error_t{"Invalid input: expected comma, read: " + comma};
-            }
+            std::ostringstream oss;
+            oss << "Invalid input: graph does not fit into index type, "
+                << "required slots: " << count_slots << ", "
+                << "max index: "      << MAX_INDEX;
+            throw error_t{oss.str()};
+        }
 
-            auto& [v1, v2, w] = edge;
-            v1 = static_cast<size_t>(v1_ - 1);
-            v2 = static_cast<size_t>(v2_ - 1);
-            w = w_;
-            return true;
+        void start_building(size_t count_edges_hint) {
+            count_verts_ = 0;
+            count_edges_ = 0;
+            free_edges_.clear();
+            original_ids_.clear();
+            internal_ids_.clear();
+
+            edges_.clear();
+            e_data_.clear();
+            edges_.reserve(2 * count_edges_hint);
+            e_data_.reserve(count_edges_hint);
         }
 
-        void resize(size_t count_verts, size_t count_edges) {
-            size_t summary_count = count_verts + 2 * count_edges;
+        void append_edge(size_t v1, size_t v2, EdgeT data = {}) {
+            check_fits_index(1 + std::max(v1, v2));
+            count_verts_ = std::max(count_verts_, 1 + std::max(v1, v2));
+            edges_.push_back(static_cast<IndexT>(v1));
+            edges_.push_back(static_cast<IndexT>(v2));
+            e_data_.push_back(std::move(data));
+        }
 
-            v_data_.resize(count_verts);
-            e_data_.resize(count_edges);
-            edges_.resize(2 * count_edges);
-            next_.resize(summary_count);
+        /* in-place counting sort of (edges_, e_data_) pairs by source vertex,
+           heads must contain count_verts_ + 1 elements */
+        void sort_by_source(vector_t<IndexT>& heads) {
+            vector_t<IndexT> ends(count_verts_ + 1, 0, get_allocator());
+            for (size_t idx = 0; idx < 2 * count_edges_; idx += 2)
+                ends[edges_[idx]]++;
+            std::partial_sum(ends.begin(), ends.end(), ends.begin());
+
+            heads[0] = 0;
+            std::copy(ends.begin(), ends.end() - 1, heads.begin() + 1);
+
+            for (size_t vertex = 0; vertex < count_verts_; ++vertex) {
+                IndexT& head = heads[vertex];
+                while (head < ends[vertex]) {
+                    IndexT source = edges_[2 * head];
+                    if (source == vertex) {
+                        ++head;
+                        continue;
+                    }
+
+                    IndexT target = heads[source]++;
+                    std::swap(edges_[2 * head],     edges_[2 * target]);
+                    std::swap(edges_[2 * head + 1], edges_[2 * target + 1]);
+                    std::swap(e_data_[head],        e_data_[target]);
+                }
+            }
         }
 
-        void create(const building_list_of_edges_t& edges) {
+        void create() {
+            GRAPH_STATS_TIMER("create");
             count_verts_ += count_verts_ % 2;
-            resize(count_verts_, count_edges_);
+            count_edges_ = edges_.size() / 2;
+            count_heads_ = count_verts_;
+            check_fits_index(count_verts_ + 2 * count_edges_);
+
+            v_data_.resize(count_verts_);
+            next_.resize(count_verts_ + 2 * count_edges_);
+
+            vector_t<IndexT> curr_idx(count_verts_ + 1, get_allocator());
+            sort_by_source(curr_idx);
 
-            std::vector<size_t> curr_idx(count_verts_);
             iota(curr_idx.begin(), curr_idx.end(), 0);
-            
-            size_t idx = 0;
-            for (auto&& edge : edges) {
-                size_t current = edge.first;
-                for (auto&& [child, edge_data] : edge.second) {
-                    edges_[idx]      = current;
-                    edges_[idx + 1]  = child;
-                    e_data_[idx / 2] = edge_data;
-
-                    curr_idx[current]  =  next_[curr_idx[current]]  =  count_verts_ + idx;
-                    curr_idx[child  ]  =  next_[curr_idx[child  ]]  =  count_verts_ + idx + 1;
-
-                    idx += 2;
-                }
+            for (size_t idx = 0; idx < 2 * count_edges_; ++idx) {
+                IndexT vertex = edges_[idx];
+                curr_idx[vertex] = next_[curr_idx[vertex]] = static_cast<IndexT>(count_verts_ + idx);
             }
 
             for (auto i : std::views::iota(0UL, count_verts_))
-                next_[curr_idx[i]] = i;
+                next_[curr_idx[i]] = static_cast<IndexT>(i);
         }
 
-        void add_edge(building_list_of_edges_t& edges, size_t v1, size_t v2, EdgeT data = {}) {
+        void add_listed_edge(size_t v1, size_t v2, EdgeT data = {}) {
             check_vertex_indexes(v1--, v2--);
-            count_verts_ = std::max(count_verts_, 1 + std::max(v1, v2));
-            edges[v1].emplace_back(v2, data);
+            append_edge(v1, v2, std::move(data));
+        }
+
+        /* vertex headers occupy first count_heads_ slots of next_, arcs follow them,
+           so new vertices past the spare headers shift every arc link */
+        void reserve_heads(size_t count_verts) {
+            if (count_verts <= count_heads_)
+                return;
+
+            size_t count_heads = std::max(count_verts, 2 * count_heads_);
+            check_fits_index(count_heads + 2 * count_edges_);
+
+            IndexT shift = static_cast<IndexT>(count_heads - count_heads_);
+            auto shifted = [&](IndexT link) { return (link < count_heads_) ? link : link + shift; };
+
+            vector_t<IndexT> next(count_heads + 2 * count_edges_, get_allocator());
+            for (size_t i = 0; i < count_heads_; ++i)
+                next[i] = shifted(next_[i]);
+            for (size_t i = count_heads_; i < count_heads; ++i)
+                next[i] = static_cast<IndexT>(i);
+            for (size_t idx = 0; idx < 2 * count_edges_; ++idx)
+                next[count_heads + idx] = shifted(next_[count_heads_ + idx]);
+
+            next_.swap(next);
+            count_heads_ = count_heads;
+        }
+
+        void link_arc(size_t idx) {
+            IndexT vertex = edges_[idx];
+            IndexT arc = static_cast<IndexT>(count_heads_ + idx);
+            next_[arc] = next_[vertex];
+            next_[vertex] = arc;
+        }
+
+        void unlink_arc(size_t idx) {
+            IndexT arc = static_cast<IndexT>(count_heads_ + idx);
+            IndexT prev = edges_[idx];
+            while (next_[prev] != arc)
+                prev = next_[prev];
+            next_[prev] = next_[arc];
+        }
+
+        /* live edges keep their order, count_heads may drop spare vertex headers */
+        void compact_slots(size_t count_heads) {
+            vector_t<IndexT> new_indexes(count_edges_, get_allocator());
+            size_t count_live = 0;
+            for (size_t e = 0; e < count_edges_; ++e)
+                new_indexes[e] = is_edge_removed(e) ? REMOVED : static_cast<IndexT>(count_live++);
+
+            auto moved = [&](IndexT link) {
+                if (link < count_heads_)
+                    return link;
+                IndexT idx = link - static_cast<IndexT>(count_heads_);
+                return static_cast<IndexT>(count_heads + 2 * new_indexes[idx / 2] + idx % 2);
+            };
+
+            for (size_t v = 0; v < count_verts_; ++v)
+                next_[v] = moved(next_[v]);
+            for (size_t e = 0; e < count_edges_; ++e) {
+                IndexT new_e = new_indexes[e];
+                if (new_e == REMOVED)
+                    continue;
+
+                for (size_t side : {0, 1}) {
+                    edges_[2 * new_e + side] = edges_[2 * e + side];
+                    next_[count_heads + 2 * new_e + side] = moved(next_[count_heads_ + 2 * e + side]);
+                }
+                if (new_e != e)
+                    e_data_[new_e] = std::move(e_data_[e]);
+            }
+
+            count_edges_ = count_live;
+            count_heads_ = count_heads;
+            edges_ .resize(2 * count_edges_);
+            e_data_.resize(count_edges_);
+            next_  .resize(count_heads_ + 2 * count_edges_);
+            free_edges_.clear();
+        }
+
+        void check_edge_index(size_t edge_index) const {
+            if (edge_index < count_edges_ && !is_edge_removed(edge_index))
+                return;
+
+            std::ostringstream oss;
+            oss << "Invalid edge index: "
+                << "index: "       << edge_index << ", "
+                << "count_edges: " << count_edges_;
+            throw error_t{oss.str()};
         }
 
         template <typename TupleT>
-        void dispatch_edge_to_add(building_list_of_edges_t& edges, TupleT&& edge) {
+        void dispatch_edge_to_add(TupleT&& edge) {
             std::apply(
                 [&](auto&&... args) {
-                    add_edge(edges, std::forward<decltype(args)>(args)...);
+                    add_listed_edge(std::forward<decltype(args)>(args)...);
                 },
                 edge
             );
@@ -233,24 +418,51 @@ namespace graph {
 
         template <typename EdgeListT>
         void init_from_edges(const EdgeListT& edges_list) {
-            building_list_of_edges_t edges;
+            start_building(edges_list.size());
             for (auto&& edge : edges_list)
-                dispatch_edge_to_add(edges, edge);
-            count_edges_ = edges_list.size();
-            create(edges);
+                dispatch_edge_to_add(edge);
+            create();
+        }
+
+        template <typename ForEachEdgeT>
+        void read_edges(ForEachEdgeT&& for_each, size_t count_edges_hint) {
+            start_building(count_edges_hint);
+            {
+                GRAPH_STATS_TIMER("parse");
+                for_each([&](const edge_t& edge) {
+                    const auto& [v1, v2, w] = edge;
+                    append_edge(v1, v2, w);
+                });
+            }
+            create();
         }
 
     public:
         graph_t() {}
 
-        graph_t(std::initializer_list<std::tuple<size_t, size_t>> edges) {
+        explicit graph_t(const AllocatorT& allocator)
+        : free_edges_(allocator), original_ids_(allocator), internal_ids_(allocator),
+          v_data_(allocator), e_data_(allocator), edges_(allocator), next_(allocator) {}
+
+        graph_t(const graph_t& other, const AllocatorT& allocator)
+        : count_verts_(other.count_verts_), count_edges_(other.count_edges_), count_heads_(other.count_heads_),
+          free_edges_(other.free_edges_, allocator), original_ids_(other.original_ids_, allocator),
+          internal_ids_(other.internal_ids_, allocator), v_data_(other.v_data_, allocator),
+          e_data_(other.e_data_, allocator), edges_(other.edges_, allocator), next_(other.next_, allocator) {}
+
+        graph_t(std::initializer_list<std::tuple<size_t, size_t>> edges, const AllocatorT& allocator = {})
+        : graph_t(allocator) {
             init_from_edges(edges);
         }
 
-        graph_t(std::initializer_list<std::tuple<size_t, size_t, const EdgeT&>> edges) {
+        graph_t(std::initializer_list<std::tuple<size_t, size_t, const EdgeT&>> edges,
+                const AllocatorT& allocator = {})
+        : graph_t(allocator) {
             init_from_edges(edges);
         }
 
+        allocator_type get_allocator() const { return allocator_type(edges_.get_allocator()); }
+
         void set_vertex_info(iterator_t iterator, const VertexT& info) {
             size_t index = iterator.index();
             check_vertex_index(index);
@@ -266,39 +478,191 @@ namespace graph {
         const VertexT& get_vertex_info(const_iterator_t iterator) const {
             size_t index = iterator.index();
             check_vertex_index(index);
-            return e_data_[index]->data;
+            return v_data_[index];
         }
 
-        std::istream& read(std::istream& is) {
-            count_verts_ = 0;
-            count_edges_ = 0;
+        std::pair<size_t, size_t> get_edge_verts(size_t edge_index) const {
+            return {edges_[2 * edge_index], edges_[2 * edge_index + 1]};
+        }
+
+        const EdgeT& get_edge_info(size_t edge_index) const {
+            return e_data_[edge_index];
+        }
 
-            edge_t edge;
-            building_list_of_edges_t edges;
-            while (read_edge(is, edge)) {
-                const auto& [v1, v2, w] = edge;
-                count_verts_ = std::max(count_verts_, 1 + std::max(v1, v2));
-                edges[v1].emplace_back(v2, w);
+        /* Adds edge between 0-based vertexes v1 and v2 to the built graph, both arcs are
+           linked at the head of children lists. Slots of removed edges are reused first,
+           else arc storage grows geometrically, vertex headers too, so the cost is
+           amortized O(1). Returns index of the new edge. */
+        size_t add_edge(size_t v1, size_t v2, EdgeT data = {}) {
+            size_t count_verts = 1 + std::max(v1, v2);
+            count_verts += count_verts % 2;
+            size_t count_new_edges = free_edges_.empty() ? 1 : 0;
+            check_fits_index(std::max(count_verts, count_heads_) + 2 * (count_edges_ + count_new_edges));
+
+            reserve_heads(count_verts);
+            if (count_verts > count_verts_) {
+                for (size_t v = count_verts_; v < count_verts && is_relabeled(); ++v) {
+                    original_ids_.push_back(static_cast<IndexT>(v));
+                    internal_ids_.push_back(static_cast<IndexT>(v));
+                }
+                count_verts_ = count_verts;
+                v_data_.resize(count_verts_);
+            }
+
+            size_t edge_index = count_edges_;
+            if (free_edges_.empty()) {
+                edges_.resize(2 * (count_edges_ + 1));
+                e_data_.resize(count_edges_ + 1);
+                next_.resize(count_heads_ + 2 * (count_edges_ + 1));
                 count_edges_++;
+            } else {
+                edge_index = free_edges_.back();
+                free_edges_.pop_back();
+            }
+
+            edges_[2 * edge_index]     = static_cast<IndexT>(v1);
+            edges_[2 * edge_index + 1] = static_cast<IndexT>(v2);
+            e_data_[edge_index] = std::move(data);
+            link_arc(2 * edge_index);
+            link_arc(2 * edge_index + 1);
+            return edge_index;
+        }
+
+        /* Unlinks both arcs from children lists in O(degree), the slot goes to the free list.
+           Indexes of other edges do not change until compact(). */
+        void remove_edge(size_t edge_index) {
+            check_edge_index(edge_index);
+            unlink_arc(2 * edge_index);
+            unlink_arc(2 * edge_index + 1);
+
+            edges_[2 * edge_index] = edges_[2 * edge_index + 1] = REMOVED;
+            e_data_[edge_index] = EdgeT{};
+            free_edges_.push_back(static_cast<IndexT>(edge_index));
+        }
+
+        bool is_edge_removed(size_t edge_index) const noexcept {
+            return edges_[2 * edge_index] == REMOVED;
+        }
+
+        /* If free slots are more than max_free_fraction of all edge slots, moves live edges
+           down in one linear pass keeping their order. Edge indexes change;
+           returns true if the graph was compacted. */
+        bool compact(double max_free_fraction = 0) {
+            if (free_edges_.empty() || free_edges_.size() <= max_free_fraction * count_edges_)
+                return false;
+
+            compact_slots(count_heads_);
+            return true;
+        }
+
+        /* Vertex new_order[i] gets internal id i, children lists are rebuilt grouped by
+           the new source ids. Ids given to and got from iterators, add_edge and traversals
+           are internal; get_bipartite reports original ids, original_id() maps the others.
+           Edge indexes change. */
+        void relabel(std::span<const IndexT> new_order) {
+            vector_t<IndexT> new_ids(count_verts_, REMOVED, get_allocator());
+            bool is_permutation = (new_order.size() == count_verts_);
+            for (size_t v = 0; v < new_order.size() && is_permutation; ++v) {
+                is_permutation = (new_order[v] < count_verts_ && new_ids[new_order[v]] == REMOVED);
+                if (is_permutation)
+                    new_ids[new_order[v]] = static_cast<IndexT>(v);
             }
-            create(edges);
+            if (!is_permutation)
+                throw error_t{"Invalid vertex order: not a permutation of " + std::to_string(count_verts_) + " vertexes"};
+
+            if (!free_edges_.empty() || count_heads_ != count_verts_)
+                compact_slots(count_verts_);
+
+            for (auto& vertex : edges_)
+                vertex = new_ids[vertex];
+
+            payload_vector_t<VertexT> v_data(count_verts_, get_allocator());
+            vector_t<IndexT> original_ids(count_verts_, get_allocator());
+            for (size_t v = 0; v < count_verts_; ++v) {
+                v_data[v] = std::move(v_data_[new_order[v]]);
+                original_ids[v] = is_relabeled() ? original_ids_[new_order[v]] : new_order[v];
+            }
+            v_data_.swap(v_data);
+            original_ids_.swap(original_ids);
+
+            internal_ids_.resize(count_verts_);
+            for (size_t v = 0; v < count_verts_; ++v)
+                internal_ids_[original_ids_[v]] = static_cast<IndexT>(v);
+
+            create();
+        }
+
+        bool is_relabeled() const noexcept { return !original_ids_.empty(); }
+
+        size_t original_id(size_t vertex) const noexcept {
+            return is_relabeled() ? original_ids_[vertex] : vertex;
+        }
+
+        size_t internal_id(size_t vertex) const noexcept {
+            return is_relabeled() ? internal_ids_[vertex] : vertex;
+        }
+
+        std::istream& read(std::istream& is, size_t count_edges_hint = 0) {
+            read_edges([&](auto&& func) { for_each_edge<EdgeT>(is, func); }, count_edges_hint);
             return is;
         }
 
+        void read(std::string_view data, size_t count_edges_hint = 0,
+                  unsigned count_threads = default_count_threads()) {
+            read_edges([&](auto&& func) { for_each_edge<EdgeT>(data, func, count_threads); },
+                       count_edges_hint);
+        }
+
+        /* builds from already parsed edges, 0-based as for_each_edge gives them */
+        void assign(std::span<const edge_t> edges) {
+            start_building(edges.size());
+            for (const auto& [v1, v2, w] : edges)
+                append_edge(v1, v2, w);
+            create();
+        }
+
+        /* snapshot has no free slots, spare vertex headers and relabeling,
+           so a mutated graph is compacted copy and a relabeled one is written in original ids */
+        std::ostream& write_snapshot(std::ostream& os) const requires snapshotable<VertexT, EdgeT, IndexT> {
+            if (is_relabeled()) {
+                graph_t original(*this, get_allocator());
+                original.relabel(internal_ids_);
+                original.original_ids_.clear();
+                original.internal_ids_.clear();
+                return original.write_snapshot(os);
+            }
+            if (count_heads_ != count_verts_ || !free_edges_.empty()) {
+                graph_t compacted(*this, get_allocator());
+                compacted.compact_slots(count_verts_);
+                return compacted.write_snapshot(os);
+            }
+            /* monostate payloads keep their byte per element in the snapshot layout, written as zeros */
+            auto get_payload = [](const auto& payload) {
+                using payload_t = std::remove_cvref_t<decltype(payload[0])>;
+                if constexpr (not_monostate<payload_t>)
+                    return std::span<const payload_t>{payload};
+                else
+                    return std::span<const payload_t>{};
+            };
+            return graph::write_snapshot<VertexT, EdgeT, IndexT>(os, count_verts_, count_edges_,
+                                                                 get_payload(v_data_), get_payload(e_data_),
+                                                                 edges_, next_);
+        }
+
         std::ostream& print(std::ostream& os) const {
             constexpr size_t LENGTH_OF_OUTPUT_NUMBERS = 4;
 
             os << print_blue("graph\n");
 
             os << print_blue("index:\t");
-            for (auto index : std::ranges::iota_view(0UL, count_verts_ + 2 * count_edges_))
+            for (auto index : std::ranges::iota_view(0UL, count_heads_ + 2 * count_edges_))
                 os << std::setw(LENGTH_OF_OUTPUT_NUMBERS) << print_lcyan(index) << '\t';
             os << '\n';
 
             os << print_blue("v_data:\t");
-            for (auto v_data : v_data_) {
+            for (auto v : std::ranges::iota_view(0UL, count_verts_)) {
                 if constexpr(not_monostate<VertexT> && has_output_operator<VertexT>)
-                    os << print_lcyan(v_data);
+                    os << print_lcyan(v_data_[v]);
                 else
                     os << print_lcyan('-');
                 os << '\t';
@@ -306,9 +670,9 @@ namespace graph {
             os << '\n';
 
             os << print_blue("e_data:\t");
-            for (auto e_data : e_data_) {
+            for (auto e : std::ranges::iota_view(0UL, count_edges_)) {
                 if constexpr(not_monostate<EdgeT> && has_output_operator<EdgeT>)
-                    os << print_lcyan(e_data);
+                    os << print_lcyan(e_data_[e]);
                 else
                     os << print_lcyan('-');
                 os << '\t';
@@ -316,7 +680,7 @@ namespace graph {
             os << '\n';
 
             os << print_blue("edges:\t");
-            for (auto _ : std::ranges::iota_view(0UL, count_verts_))
+            for (auto _ : std::ranges::iota_view(0UL, count_heads_))
                 os << std::setw(LENGTH_OF_OUTPUT_NUMBERS) << print_lcyan('-') << '\t';
             for (auto edge : edges_)
                 os << std::setw(LENGTH_OF_OUTPUT_NUMBERS) << print_lcyan(edge) << '\t';
@@ -338,87 +702,75 @@ namespace graph {
         }
 
         size_t count_verts() const noexcept { return count_verts_; }
+        size_t count_edges() const noexcept { return count_edges_ - free_edges_.size(); }
+
+        /* edge indexes are [0, count_edge_slots()), removed ones included */
+        size_t count_edge_slots() const noexcept { return count_edges_; }
     };
 
+    /* callback gets vertexes in reversed dfs_range order */
     template <typename GraphT, typename Func, typename... Args>
     inline void do_dfs(const GraphT& graph, typename GraphT::const_iterator_t start,
+                       traversal_workspace_t<typename GraphT::index_t>& workspace,
                        Func&& func, Args&&... args) {
-        std::stack<size_t> s;
-
-        size_t count_verts = graph.count_verts();
-        std::vector<bool> used(count_verts, false);
-        std::vector<size_t> order;
-        order.reserve(count_verts);
-
-        size_t start_index = start.index();
-        used[start_index] = true;
-        s.push(start_index);
-        while (!s.empty()) {
-            size_t v = s.top();
-            s.pop();
-            order.push_back(v);
-
-            for (auto i : graph.get_range_children({graph, v})) {
-                size_t next = i.index();
-                if (!used[next]) {
-                    used[next] = true;
-                    s.push(next);
-                }
-            }
-        }
+        GRAPH_STATS_TIMER("do_dfs");
+        /* dfs_range keeps its vertexes on stack(), order() is free after begin() clears it */
+        auto& order = workspace.order();
+        for (auto step : dfs_range(graph, start, workspace))
+            order.push_back(step.vertex);
+        GRAPH_STATS_ADD(vertexes_visited, order.size());
 
         for (auto v : std::views::reverse(order))
             std::invoke(std::forward<Func>(func), v, std::forward<Args>(args)...);
     }
 
     template <typename GraphT, typename Func, typename... Args>
-    inline void do_bfs(const GraphT& graph, typename GraphT::const_iterator_t start,
+    inline void do_dfs(const GraphT& graph, typename GraphT::const_iterator_t start,
                        Func&& func, Args&&... args) {
-        std::queue<size_t> q;
+        details::with_workspace<typename GraphT::index_t>([&](auto& workspace) {
+            do_dfs(graph, start, workspace, std::forward<Func>(func), std::forward<Args>(args)...);
+        });
+    }
 
-        size_t count_verts = graph.count_verts();
-        std::vector<bool> used(count_verts, false);
-        std::vector<size_t> order;
-        order.reserve(count_verts);
-
-        size_t start_index = start.index();
-        used[start_index] = true;
-        q.push(start_index);
-        while (!q.empty()) {
-            size_t v = q.front();
-            q.pop();
-            order.push_back(v);
-
-            for (auto i : graph.get_range_children({graph, v})) {
-                size_t next = i.index();
-                if (!used[next]) {
-                    used[next] = true;
-                    q.push(next);
-                }
-            }
-        }
+    template <typename GraphT, typename Func, typename... Args>
+    inline void do_bfs(const GraphT& graph, typename GraphT::const_iterator_t start,
+                       traversal_workspace_t<typename GraphT::index_t>& workspace,
+                       Func&& func, Args&&... args) {
+        GRAPH_STATS_TIMER("do_bfs");
+        auto range = bfs_range(graph, start, workspace);
+        for (auto step : range)
+            std::invoke(std::forward<Func>(func), step.vertex, std::forward<Args>(args)...);
+        GRAPH_STATS_ADD(vertexes_visited, workspace.order().size());
+        GRAPH_STATS_MAX(queue_high_water, range.queue_high_water());
+    }
 
-        for (auto v : order)
-            std::invoke(std::forward<Func>(func), v, std::forward<Args>(args)...);
+    template <typename GraphT, typename Func, typename... Args>
+    inline void do_bfs(const GraphT& graph, typename GraphT::const_iterator_t start,
+                       Func&& func, Args&&... args) {
+        details::with_workspace<typename GraphT::index_t>([&](auto& workspace) {
+            do_bfs(graph, start, workspace, std::forward<Func>(func), std::forward<Args>(args)...);
+        });
     }
 
+    template <typename ParentsT, typename IndexT>
     inline std::vector<size_t> get_odd_cycle(size_t u, size_t v, size_t count_verts,
-                                             std::span<size_t> parents) {
+                                             const ParentsT& parents, traversal_workspace_t<IndexT>& workspace) {
         if (u == v)
             return std::vector(3, u);
 
-        std::vector<bool> visited(count_verts, false);
+        /* parents may be workspace.parents() of the traversal that found u and v */
+        workspace.start_marks(count_verts);
         std::vector<size_t> cycle;
 
         size_t end_parent = count_verts + 1;
 
         for (size_t i = u; i != end_parent; i = parents[i])
-            visited[i] = true;
+            workspace.mark(i);
 
         size_t lsa = end_parent;
         for (size_t i = v; i != end_parent; i = parents[i]) {
             cycle.push_back(i + 1);
-            if (visited[i]) {
+            if (workspace.is_marked(i)) {
                 lsa = i;
                 break;
             }
@@ -433,51 +785,152 @@ namespace graph {
         return cycle;
     }
 
+    template <typename ParentsT>
+    inline std::vector<size_t> get_odd_cycle(size_t u, size_t v, size_t count_verts,
+                                             const ParentsT& parents) {
+        return details::with_workspace<size_t>([&](auto& workspace) {
+            return get_odd_cycle(u, v, count_verts, parents, workspace);
+        });
+    }
+
     struct get_bipartite_result_t final {
         bool is_bipartite;
         std::vector<int> colors;
         std::vector<size_t> cycle;
     };
 
+    /* identity for graphs without relabeling */
     template <typename GraphT>
-    inline get_bipartite_result_t get_bipartite(const GraphT& graph) {
+    inline size_t original_id(const GraphT& graph, size_t vertex) {
+        if constexpr (requires { graph.original_id(vertex); })
+            return graph.original_id(vertex);
+        else
+            return vertex;
+    }
+
+    template <typename GraphT>
+    inline size_t internal_id(const GraphT& graph, size_t vertex) {
+        if constexpr (requires { graph.internal_id(vertex); })
+            return graph.internal_id(vertex);
+        else
+            return vertex;
+    }
+
+    namespace details {
+        template <typename GraphT>
+        inline bool is_relabeled(const GraphT& graph) {
+            if constexpr (requires { graph.is_relabeled(); })
+                return graph.is_relabeled();
+            else
+                return false;
+        }
+
+        /* parents of internal ids as get_odd_cycle walks them in original ids */
+        template <typename GraphT, typename ParentsT>
+        struct original_parents_t final {
+            const GraphT&   graph;
+            const ParentsT& parents;
+            size_t end_parent;
+
+            size_t operator[](size_t vertex) const {
+                size_t parent = parents[internal_id(graph, vertex)];
+                return (parent == end_parent) ? end_parent : original_id(graph, parent);
+            }
+        };
+
+        template <typename GraphT, typename ParentsT, typename IndexT>
+        inline std::vector<size_t> get_original_odd_cycle(const GraphT& graph, size_t u, size_t v,
+                                                          const ParentsT& parents,
+                                                          traversal_workspace_t<IndexT>& workspace) {
+            size_t count_verts = graph.count_verts();
+            if (!is_relabeled(graph))
+                return get_odd_cycle(u, v, count_verts, parents, workspace);
+
+            original_parents_t<GraphT, ParentsT> original_parents{graph, parents, count_verts + 1};
+            return get_odd_cycle(original_id(graph, u), original_id(graph, v), count_verts,
+                                 original_parents, workspace);
+        }
+
+        template <typename GraphT>
+        inline std::vector<int> get_original_colors(const GraphT& graph, std::vector<int>&& colors) {
+            if (!is_relabeled(graph))
+                return std::move(colors);
+
+            std::vector<int> original(colors.size());
+            for (size_t v = 0; v < colors.size(); ++v)
+                original[original_id(graph, v)] = colors[v];
+            return original;
+        }
+    }
+
+    template <typename GraphT>
+    inline get_bipartite_result_t get_bipartite(const GraphT& graph,
+                                                traversal_workspace_t<typename GraphT::index_t>& workspace) {
+        using index_t = typename GraphT::index_t;
+        GRAPH_STATS_TIMER("get_bipartite");
+
         size_t count_verts = graph.count_verts();
+        index_t end_parent = static_cast<index_t>(count_verts + 1);
         std::vector<int> colors (count_verts, -1);
-        std::vector<size_t> parents(count_verts, count_verts + 1);
-        std::queue<size_t> q;
+
+        workspace.start(count_verts);
+        auto& parents = workspace.parents();
+        auto& q = workspace.order();
+        [[maybe_unused]] size_t max_queue = 0;
 
         for (auto v : std::views::iota(0UL, count_verts)) {
             if (colors[v] == -1) {
-                q.push(v);
+                q.assign(1, static_cast<index_t>(v));
                 colors[v] = 0;
-    
-                while (!q.empty()) {
-                    size_t u = q.front();
-                    q.pop();
+                parents[v] = end_parent;
+
+                for (size_t head = 0; head < q.size(); ++head) {
+                    index_t u = q[head];
+                    max_queue = std::max(max_queue, q.size() - head);
 
                     for (auto i : graph.get_range_children({graph, u})) {
-                        size_t next = i.index();
+                        index_t next = i.index();
                         if (colors[next] == -1) {
                             colors[next] = !colors[u];
                             parents[next] = u;
-                            q.push(next);
+                            q.push_back(next);
                         } else if (colors[next] == colors[u]) {
-                            return {false, {}, get_odd_cycle(u, next, count_verts, parents)};
+                            GRAPH_STATS_ADD(vertexes_visited, q.size());
+                            GRAPH_STATS_MAX(queue_high_water, std::max(max_queue, q.size() - head));
+                            return {false, {}, details::get_original_odd_cycle(graph, u, next, parents, workspace)};
                         }
                     }
                 }
+
+                GRAPH_STATS_ADD(vertexes_visited, q.size());
+                GRAPH_STATS_MAX(queue_high_water, max_queue);
+
+                /* component of a relabeled graph is colored from its minimal original vertex */
+                if (details::is_relabeled(graph)) {
+                    auto first = std::ranges::min(q, {}, [&](index_t u) { return original_id(graph, u); });
+                    if (colors[first] == 1)
+                        for (auto u : q)
+                            colors[u] ^= 1;
+                }
             }
         }
-        return {true, colors, {}};
+        return {true, details::get_original_colors(graph, std::move(colors)), {}};
+    }
+
+    template <typename GraphT>
+    inline get_bipartite_result_t get_bipartite(const GraphT& graph) {
+        return details::with_workspace<typename GraphT::index_t>([&](auto& workspace) {
+            return get_bipartite(graph, workspace);
+        });
     }
 
-    template <typename VertexT = std::monostate, typename EdgeT = std::monostate>
-    inline std::istream& operator>>(std::istream& is, graph_t<VertexT, EdgeT>& graph) {
+    template <typename VertexT, typename EdgeT, typename IndexT, typename AllocatorT>
+    inline std::istream& operator>>(std::istream& is, graph_t<VertexT, EdgeT, IndexT, AllocatorT>& graph) {
         return graph.read(is);
     }
 
-    template <typename VertexT = std::monostate, typename EdgeT = std::monostate>
-    inline std::ostream& operator<<(std::ostream& os, const graph_t<VertexT, EdgeT>& graph) {
+    template <typename VertexT, typename EdgeT, typename IndexT, typename AllocatorT>
+    inline std::ostream& operator<<(std::ostream& os, const graph_t<VertexT, EdgeT, IndexT, AllocatorT>& graph) {
         return graph.print(os);
     }
 }
\ No newline at end of file
@@ -0,0 +1,261 @@
+#pragma once
+
+#include "Graph/graph.hpp"
+#include "Graph/parallel.hpp"
+#include "Graph/stats.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <barrier>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace graph {
+    template <typename IndexT>
+    struct matching_result_t final {
+        static constexpr IndexT NO_MATE = std::numeric_limits<IndexT>::max();
+
+        /* in ids of get_bipartite colors, mates[v] == NO_MATE for unmatched v */
+        std::vector<IndexT> mates;
+        size_t size = 0;
+
+        bool is_matched(size_t vertex) const noexcept { return mates[vertex] != NO_MATE; }
+    };
+
+    /* Hopcroft-Karp over the 2-coloring of get_bipartite: vertexes of color 0 (left)
+       and 1 (right) get compact ids of their side, left children are copied into
+       CSR of right ids. Every phase builds layers by BFS from free left vertexes,
+       then augments along vertex-disjoint shortest paths by DFS with edge pointers.
+       Layer and stack buffers are allocated once. With count_threads > 1 layers of
+       BFS are expanded by all threads, DFS stays sequential. */
+    template <typename GraphT>
+    class hopcroft_karp_t final {
+        using index_t  = typename GraphT::index_t;
+        using result_t = matching_result_t<index_t>;
+
+        static constexpr index_t NONE       = std::numeric_limits<index_t>::max();
+        static constexpr size_t  CHUNK_SIZE = 256;
+
+    private:
+        const GraphT* graph_;
+        unsigned count_threads_;
+
+        /* side ids back to graph vertexes */
+        std::vector<index_t> left_verts_;
+        std::vector<index_t> right_verts_;
+
+        std::vector<index_t> offsets_;
+        std::vector<index_t> neighbors_;
+
+        std::vector<index_t> left_mates_;
+        std::vector<index_t> right_mates_;
+
+        std::vector<index_t> layers_;
+        std::vector<index_t> edge_positions_;
+        std::vector<index_t> queue_;
+        std::vector<std::pair<index_t, index_t>> stack_;
+        index_t free_layer_ = NONE;
+
+        atomic_bitset_t claimed_;
+        std::vector<std::vector<index_t>> local_queues_;
+        std::vector<uint8_t> local_found_;
+
+    private:
+        void split_sides(const get_bipartite_result_t& bipartite) {
+            size_t count_verts = graph_->count_verts();
+            if (!bipartite.is_bipartite)
+                throw error_t{"Graph is not bipartite"};
+            if (bipartite.colors.size() != count_verts)
+                throw error_t{"Invalid count of colors: " + std::to_string(bipartite.colors.size())};
+
+            std::vector<index_t> side_ids(count_verts);
+            for (size_t v = 0; v < count_verts; ++v) {
+                auto& side = bipartite.colors[original_id(*graph_, v)] ? right_verts_ : left_verts_;
+                side_ids[v] = static_cast<index_t>(side.size());
+                side.push_back(static_cast<index_t>(v));
+            }
+
+            offsets_.reserve(left_verts_.size() + 1);
+            offsets_.push_back(0);
+            for (auto v : left_verts_) {
+                for (auto child : graph_->get_range_children({*graph_, v}))
+                    neighbors_.push_back(side_ids[child.index()]);
+                offsets_.push_back(static_cast<index_t>(neighbors_.size()));
+            }
+        }
+
+        /* returns true if left has a free right child */
+        template <bool IsParallel>
+        bool expand(index_t left, std::vector<index_t>& next) {
+            bool is_found = false;
+            for (index_t i = offsets_[left]; i < offsets_[left + 1]; ++i) {
+                index_t mate = right_mates_[neighbors_[i]];
+                if (mate == NONE) {
+                    is_found = true;
+                    continue;
+                }
+
+                bool is_new = IsParallel ? claimed_.set(mate) : (layers_[mate] == NONE);
+                if (is_new) {
+                    layers_[mate] = layers_[left] + 1;
+                    next.push_back(mate);
+                }
+            }
+            return is_found;
+        }
+
+        void build_layers_parallel() {
+            claimed_.clear();
+            for (auto l : queue_)
+                claimed_.set(l);
+
+            size_t level_begin = 0, level_end = queue_.size();
+            std::atomic<size_t> next_chunk = 0;
+            std::barrier sync{static_cast<std::ptrdiff_t>(count_threads_), [&]() noexcept {
+                bool is_found = false;
+                for (unsigned i = 0; i < count_threads_; ++i) {
+                    is_found |= local_found_[i];
+                    queue_.insert(queue_.end(), local_queues_[i].begin(), local_queues_[i].end());
+                    local_queues_[i].clear();
+                }
+                if (is_found)
+                    free_layer_ = layers_[queue_[level_begin]] + 1;
+
+                level_begin = level_end;
+                level_end = queue_.size();
+                next_chunk.store(level_begin);
+            }};
+
+            run_parallel(count_threads_, [&](unsigned thread_index) {
+                while (level_begin < level_end && free_layer_ == NONE) {
+                    local_found_[thread_index] = false;
+                    for (size_t begin = next_chunk.fetch_add(CHUNK_SIZE); begin < level_end;
+                                begin = next_chunk.fetch_add(CHUNK_SIZE)) {
+                        size_t end = std::min(begin + CHUNK_SIZE, level_end);
+                        for (size_t i = begin; i < end; ++i)
+                            if (expand<true>(queue_[i], local_queues_[thread_index]))
+                                local_found_[thread_index] = true;
+                    }
+                    sync.arrive_and_wait();
+                }
+            });
+        }
+
+        /* layers of left vertexes from free ones, up to the first with a free right child */
+        bool build_layers() {
+            queue_.clear();
+            for (size_t l = 0; l < left_verts_.size(); ++l) {
+                layers_[l] = (left_mates_[l] == NONE) ? 0 : NONE;
+                if (left_mates_[l] == NONE)
+                    queue_.push_back(static_cast<index_t>(l));
+            }
+
+            free_layer_ = NONE;
+            if (count_threads_ > 1) {
+                build_layers_parallel();
+                return free_layer_ != NONE;
+            }
+
+            for (size_t level_begin = 0; level_begin < queue_.size() && free_layer_ == NONE;) {
+                size_t level_end = queue_.size();
+                bool is_found = false;
+                for (size_t i = level_begin; i < level_end; ++i)
+                    is_found |= expand<false>(queue_[i], queue_);
+                if (is_found)
+                    free_layer_ = layers_[queue_[level_begin]] + 1;
+                level_begin = level_end;
+            }
+            return free_layer_ != NONE;
+        }
+
+        /* DFS along layers, edge_positions_ skip children tried earlier in the phase */
+        bool augment(index_t root) {
+            stack_.assign(1, {root, NONE});
+            while (!stack_.empty()) {
+                index_t left = stack_.back().first;
+                if (edge_positions_[left] == offsets_[left + 1] || layers_[left] >= free_layer_) {
+                    layers_[left] = NONE;
+                    stack_.pop_back();
+                    continue;
+                }
+
+                index_t right = neighbors_[edge_positions_[left]++];
+                index_t mate  = right_mates_[right];
+                if (mate == NONE && layers_[left] + 1 == free_layer_) {
+                    stack_.back().second = right;
+                    for (auto [l, r] : stack_) {
+                        left_mates_ [l] = r;
+                        right_mates_[r] = l;
+                        layers_[l] = NONE;
+                    }
+                    return true;
+                }
+
+                if (mate != NONE && layers_[mate] == layers_[left] + 1 && layers_[mate] < free_layer_) {
+                    stack_.back().second = right;
+                    stack_.emplace_back(mate, NONE);
+                }
+            }
+            return false;
+        }
+
+    public:
+        hopcroft_karp_t(const GraphT& graph, const get_bipartite_result_t& bipartite, unsigned count_threads = 1)
+        : graph_(&graph), count_threads_(std::max(count_threads, 1U)),
+          local_queues_(count_threads_), local_found_(count_threads_, 0) {
+            split_sides(bipartite);
+            left_mates_ .assign(left_verts_.size(),  NONE);
+            right_mates_.assign(right_verts_.size(), NONE);
+            layers_        .resize(left_verts_.size());
+            edge_positions_.resize(left_verts_.size());
+            if (count_threads_ > 1)
+                claimed_ = atomic_bitset_t{left_verts_.size()};
+        }
+
+        result_t run() {
+            /* greedy matching cuts the count of phases */
+            for (size_t l = 0; l < left_verts_.size(); ++l) {
+                for (index_t i = offsets_[l]; i < offsets_[l + 1]; ++i) {
+                    if (right_mates_[neighbors_[i]] == NONE) {
+                        left_mates_ [l] = neighbors_[i];
+                        right_mates_[neighbors_[i]] = static_cast<index_t>(l);
+                        break;
+                    }
+                }
+            }
+
+            while (build_layers()) {
+                std::copy(offsets_.begin(), offsets_.end() - 1, edge_positions_.begin());
+                bool is_augmented = false;
+                for (size_t l = 0; l < left_verts_.size(); ++l)
+                    if (left_mates_[l] == NONE)
+                        is_augmented |= augment(static_cast<index_t>(l));
+                if (!is_augmented)
+                    break;
+            }
+
+            result_t result{std::vector<index_t>(graph_->count_verts(), result_t::NO_MATE)};
+            for (size_t l = 0; l < left_verts_.size(); ++l) {
+                if (left_mates_[l] == NONE)
+                    continue;
+
+                size_t u = original_id(*graph_, left_verts_[l]);
+                size_t v = original_id(*graph_, right_verts_[left_mates_[l]]);
+                result.mates[u] = static_cast<index_t>(v);
+                result.mates[v] = static_cast<index_t>(u);
+                result.size++;
+            }
+            return result;
+        }
+    };
+
+    template <typename GraphT>
+    inline matching_result_t<typename GraphT::index_t>
+    get_maximum_matching(const GraphT& graph, const get_bipartite_result_t& bipartite, unsigned count_threads = 1) {
+        GRAPH_STATS_TIMER("get_maximum_matching");
+        hopcroft_karp_t<GraphT> hopcroft_karp{graph, bipartite, count_threads};
+        return hopcroft_karp.run();
+    }
+}
\ No newline at end of file
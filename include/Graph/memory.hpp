@@ -0,0 +1,68 @@
+#pragma once
+
+#include "Graph/graph.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <new>
+#include <variant>
+
+#include <sys/mman.h>
+
+namespace graph {
+    template <typename VertexT = std::monostate, typename EdgeT = std::monostate, typename IndexT = size_t>
+    using pmr_graph_t = graph_t<VertexT, EdgeT, IndexT, std::pmr::polymorphic_allocator<std::byte>>;
+
+    /* Large blocks are anonymous mappings aligned to 2 MiB and advised as huge pages,
+       so arrays of a big graph take few TLB entries; small ones go to upstream.
+       Transparent huge pages are a hint, without them it is plain mmap. */
+    class hugepage_resource_t final : public std::pmr::memory_resource {
+        static constexpr size_t HUGE_PAGE_SIZE = 2 << 20;
+
+        std::pmr::memory_resource* upstream_;
+        size_t min_size_;
+
+        static size_t get_mapped_size(size_t bytes) noexcept {
+            return (bytes + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE;
+        }
+
+        void* do_allocate(size_t bytes, size_t alignment) override {
+            if (bytes < min_size_ || alignment > HUGE_PAGE_SIZE)
+                return upstream_->allocate(bytes, alignment);
+
+            size_t size = get_mapped_size(bytes);
+            void* mapped = mmap(nullptr, size + HUGE_PAGE_SIZE, PROT_READ | PROT_WRITE,
+                                MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (mapped == MAP_FAILED)
+                throw std::bad_alloc{};
+
+            /* trim the mapping to the aligned block */
+            char* begin   = static_cast<char*>(mapped);
+            char* aligned = begin + (HUGE_PAGE_SIZE - reinterpret_cast<uintptr_t>(begin) % HUGE_PAGE_SIZE) % HUGE_PAGE_SIZE;
+            char* end     = begin + size + HUGE_PAGE_SIZE;
+            if (aligned != begin)
+                munmap(begin, aligned - begin);
+            if (aligned + size != end)
+                munmap(aligned + size, end - (aligned + size));
+
+            madvise(aligned, size, MADV_HUGEPAGE);
+            return aligned;
+        }
+
+        void do_deallocate(void* ptr, size_t bytes, size_t alignment) override {
+            if (bytes < min_size_ || alignment > HUGE_PAGE_SIZE)
+                return upstream_->deallocate(ptr, bytes, alignment);
+            munmap(ptr, get_mapped_size(bytes));
+        }
+
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+            return this == &other;
+        }
+
+    public:
+        explicit hugepage_resource_t(size_t min_size = HUGE_PAGE_SIZE,
+                                     std::pmr::memory_resource* upstream = std::pmr::get_default_resource())
+        : upstream_(upstream), min_size_(min_size) {}
+    };
+}
\ No newline at end of file
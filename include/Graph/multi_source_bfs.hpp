@@ -0,0 +1,128 @@
+#pragma once
+
+#include "Graph/common.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace graph {
+    template <typename IndexT>
+    struct multi_source_bfs_result_t final {
+        static constexpr IndexT NOT_REACHED = std::numeric_limits<IndexT>::max();
+        static constexpr size_t WORD_SIZE   = 64;
+
+        size_t count_verts = 0;
+        size_t batch_width = 0;
+
+        /* distances[source_number * count_verts + vertex], empty if not requested */
+        std::vector<IndexT> distances;
+        /* for every batch of WORD_SIZE * batch_width sources: batch_width words per vertex */
+        std::vector<uint64_t> reached;
+
+        bool is_reachable(size_t source_number, size_t vertex) const noexcept {
+            size_t batch_size = WORD_SIZE * batch_width;
+            size_t batch = source_number / batch_size, bit = source_number % batch_size;
+            uint64_t word = reached[(batch * count_verts + vertex) * batch_width + bit / WORD_SIZE];
+            return (word >> (bit % WORD_SIZE)) & 1;
+        }
+
+        IndexT distance(size_t source_number, size_t vertex) const noexcept {
+            return distances[source_number * count_verts + vertex];
+        }
+    };
+
+    /* MS-BFS (Then et al.): sources are taken in batches of 64 * Width, every vertex keeps
+       Width words of seen/visit/next bits, one per source, so one sweep over the children
+       per level serves the whole batch. Word loops are plain, the compiler vectorizes them. */
+    template <size_t Width = 1, typename GraphT>
+    inline multi_source_bfs_result_t<typename GraphT::index_t>
+    do_multi_source_bfs(const GraphT& graph, std::span<const typename GraphT::index_t> sources,
+                        bool with_distances = true) {
+        using index_t  = typename GraphT::index_t;
+        using result_t = multi_source_bfs_result_t<index_t>;
+        static_assert(Width > 0, "Width must be positive");
+        constexpr size_t WORD_SIZE  = result_t::WORD_SIZE;
+        constexpr size_t BATCH_SIZE = WORD_SIZE * Width;
+
+        size_t count_verts = graph.count_verts();
+        for (auto source : sources)
+            if (source >= count_verts)
+                throw error_t{"Invalid vertex index: " + std::to_string(source)};
+
+        size_t count_batches = (sources.size() + BATCH_SIZE - 1) / BATCH_SIZE;
+        result_t result{count_verts, Width, {}, std::vector<uint64_t>(count_batches * count_verts * Width, 0)};
+        if (with_distances)
+            result.distances.assign(sources.size() * count_verts, result_t::NOT_REACHED);
+
+        std::vector<uint64_t> visit(count_verts * Width), next(count_verts * Width);
+        auto is_empty = [](const uint64_t* mask) {
+            uint64_t any = 0;
+            for (size_t w = 0; w < Width; ++w)
+                any |= mask[w];
+            return any == 0;
+        };
+
+        for (size_t batch = 0; batch < count_batches; ++batch) {
+            size_t batch_begin = batch * BATCH_SIZE;
+            size_t batch_end = std::min(batch_begin + BATCH_SIZE, sources.size());
+            uint64_t* seen = result.reached.data() + batch * count_verts * Width;
+
+            std::fill(visit.begin(), visit.end(), 0);
+            for (size_t i = batch_begin; i < batch_end; ++i) {
+                size_t bit = i - batch_begin;
+                uint64_t mask = uint64_t{1} << (bit % WORD_SIZE);
+                visit[sources[i] * Width + bit / WORD_SIZE] |= mask;
+                seen [sources[i] * Width + bit / WORD_SIZE] |= mask;
+                if (with_distances)
+                    result.distances[i * count_verts + sources[i]] = 0;
+            }
+
+            for (index_t level = 1;; ++level) {
+                std::fill(next.begin(), next.end(), 0);
+                for (size_t v = 0; v < count_verts; ++v) {
+                    const uint64_t* visit_v = visit.data() + v * Width;
+                    if (is_empty(visit_v))
+                        continue;
+
+                    for (auto child : graph.get_range_children({graph, v})) {
+                        uint64_t* next_child = next.data() + child.index() * Width;
+                        for (size_t w = 0; w < Width; ++w)
+                            next_child[w] |= visit_v[w];
+                    }
+                }
+
+                bool is_frontier_empty = true;
+                for (size_t v = 0; v < count_verts; ++v) {
+                    uint64_t* next_v = next.data() + v * Width;
+                    uint64_t* seen_v = seen + v * Width;
+                    for (size_t w = 0; w < Width; ++w) {
+                        next_v[w] &= ~seen_v[w];
+                        seen_v[w] |= next_v[w];
+                    }
+                    if (is_empty(next_v))
+                        continue;
+
+                    is_frontier_empty = false;
+                    if (!with_distances)
+                        continue;
+                    for (size_t w = 0; w < Width; ++w) {
+                        for (uint64_t bits = next_v[w]; bits; bits &= bits - 1) {
+                            size_t i = batch_begin + w * WORD_SIZE + std::countr_zero(bits);
+                            result.distances[i * count_verts + v] = level;
+                        }
+                    }
+                }
+
+                if (is_frontier_empty)
+                    break;
+                visit.swap(next);
+            }
+        }
+        return result;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <thread>
+#include <vector>
+
+namespace graph {
+    inline unsigned default_count_threads() noexcept {
+        unsigned count_threads = std::thread::hardware_concurrency();
+        return count_threads ? count_threads : 1;
+    }
+
+    /* Calls func(thread_index) for every thread_index in [0, count_threads),
+       the calling thread takes index 0. First exception by index is rethrown. */
+    template <typename Func>
+    inline void run_parallel(unsigned count_threads, Func&& func) {
+        std::vector<std::exception_ptr> errors(count_threads);
+        auto run = [&](unsigned thread_index) {
+            try {
+                func(thread_index);
+            } catch (...) {
+                errors[thread_index] = std::current_exception();
+            }
+        };
+
+        {
+            std::vector<std::jthread> threads;
+            threads.reserve(count_threads);
+            for (unsigned i = 1; i < count_threads; ++i)
+                threads.emplace_back(run, i);
+            run(0);
+        }
+
+        for (auto& error : errors)
+            if (error)
+                std::rethrow_exception(error);
+    }
+
+    class atomic_bitset_t final {
+        static constexpr size_t WORD_SIZE = 64;
+
+        std::vector<std::atomic<uint64_t>> words_;
+
+    public:
+        atomic_bitset_t(size_t size = 0) : words_((size + WORD_SIZE - 1) / WORD_SIZE) {}
+
+        bool test(size_t index) const noexcept {
+            uint64_t mask = uint64_t{1} << (index % WORD_SIZE);
+            return words_[index / WORD_SIZE].load(std::memory_order_relaxed) & mask;
+        }
+
+        /* returns true if the bit was set by this call */
+        bool set(size_t index) noexcept {
+            uint64_t mask = uint64_t{1} << (index % WORD_SIZE);
+            if (words_[index / WORD_SIZE].load(std::memory_order_relaxed) & mask)
+                return false;
+            return !(words_[index / WORD_SIZE].fetch_or(mask, std::memory_order_relaxed) & mask);
+        }
+
+        void clear() noexcept {
+            for (auto& word : words_)
+                word.store(0, std::memory_order_relaxed);
+        }
+
+        size_t count_words() const noexcept { return words_.size(); }
+    };
+}
\ No newline at end of file
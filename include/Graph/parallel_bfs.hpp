@@ -0,0 +1,241 @@
+#pragma once
+
+#include "Graph/common.hpp"
+#include "Graph/parallel.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <barrier>
+#include <exception>
+#include <limits>
+#include <span>
+#include <vector>
+
+namespace graph {
+    template <typename IndexT>
+    struct parallel_bfs_result_t final {
+        static constexpr IndexT NOT_VISITED = std::numeric_limits<IndexT>::max();
+
+        std::vector<IndexT> levels;
+        std::vector<IndexT> parents;
+
+        bool is_visited(size_t vertex) const noexcept { return levels[vertex] != NOT_VISITED; }
+    };
+
+    /* Level-synchronous BFS shared by count_threads threads, which switches between
+       top-down (expand frontier) and bottom-up (unvisited vertices look for a parent
+       in frontier) steps depending on frontier size (Beamer et al.).
+       Several run() calls from different roots accumulate into the same result. */
+    template <typename GraphT>
+    class parallel_bfs_t final {
+        using index_t  = typename GraphT::index_t;
+        using result_t = parallel_bfs_result_t<index_t>;
+
+        static constexpr index_t NOT_VISITED = result_t::NOT_VISITED;
+        static constexpr size_t  ALPHA       = 14;
+        static constexpr size_t  BETA        = 24;
+        static constexpr size_t  CHUNK_SIZE  = 256;
+
+    private:
+        const GraphT* graph_;
+        unsigned count_threads_;
+        size_t count_verts_;
+        size_t count_visited_ = 0;
+
+        result_t result_;
+        atomic_bitset_t visited_;
+        atomic_bitset_t frontier_bits_;
+        atomic_bitset_t next_bits_;
+
+        std::vector<index_t> frontier_;
+        std::vector<std::vector<index_t>> local_frontiers_;
+        std::atomic<size_t> next_chunk_;
+
+        index_t depth_ = 0;
+        bool is_bottom_up_ = false;
+
+    private:
+        void visit(index_t vertex, index_t parent, unsigned thread_index) {
+            result_.levels [vertex] = depth_ + 1;
+            result_.parents[vertex] = parent;
+            local_frontiers_[thread_index].push_back(vertex);
+        }
+
+        void top_down_step(unsigned thread_index) {
+            size_t frontier_size = frontier_.size();
+            for (size_t begin = next_chunk_.fetch_add(CHUNK_SIZE); begin < frontier_size;
+                        begin = next_chunk_.fetch_add(CHUNK_SIZE)) {
+                size_t end = std::min(begin + CHUNK_SIZE, frontier_size);
+                for (size_t i = begin; i < end; ++i) {
+                    index_t u = frontier_[i];
+                    for (auto child : graph_->get_range_children({*graph_, u})) {
+                        index_t next = child.index();
+                        if (!visited_.test(next) && visited_.set(next))
+                            visit(next, u, thread_index);
+                    }
+                }
+            }
+        }
+
+        void bottom_up_step(unsigned thread_index) {
+            for (size_t begin = next_chunk_.fetch_add(CHUNK_SIZE); begin < count_verts_;
+                        begin = next_chunk_.fetch_add(CHUNK_SIZE)) {
+                size_t end = std::min(begin + CHUNK_SIZE, count_verts_);
+                for (size_t v = begin; v < end; ++v) {
+                    if (visited_.test(v))
+                        continue;
+
+                    for (auto child : graph_->get_range_children({*graph_, v})) {
+                        index_t parent = child.index();
+                        if (frontier_bits_.test(parent)) {
+                            visited_.set(v);
+                            next_bits_.set(v);
+                            visit(static_cast<index_t>(v), parent, thread_index);
+                            break;
+                        }
+                    }
+                }
+            }
+        }
+
+        /* runs on one thread between levels, frontier_ is reserved for all vertexes,
+           so it does not allocate */
+        void finish_level() noexcept {
+            size_t next_size = 0;
+            for (auto& local : local_frontiers_)
+                next_size += local.size();
+
+            frontier_.clear();
+            for (auto& local : local_frontiers_) {
+                frontier_.insert(frontier_.end(), local.begin(), local.end());
+                local.clear();
+            }
+
+            count_visited_ += next_size;
+            bool was_bottom_up = is_bottom_up_;
+            if (!is_bottom_up_)
+                is_bottom_up_ = (next_size > (count_verts_ - count_visited_) / ALPHA);
+            else
+                is_bottom_up_ = (next_size >= count_verts_ / BETA);
+
+            if (is_bottom_up_ && was_bottom_up) {
+                std::swap(frontier_bits_, next_bits_);
+            } else if (is_bottom_up_) {
+                frontier_bits_.clear();
+                for (auto v : frontier_)
+                    frontier_bits_.set(v);
+            }
+            if (was_bottom_up)
+                next_bits_.clear();
+
+            depth_++;
+            next_chunk_.store(0);
+        }
+
+    public:
+        parallel_bfs_t(const GraphT& graph, unsigned count_threads = default_count_threads())
+        : graph_(&graph), count_threads_(std::max(count_threads, 1U)), count_verts_(graph.count_verts()),
+          result_{std::vector<index_t>(count_verts_, NOT_VISITED), std::vector<index_t>(count_verts_, NOT_VISITED)},
+          visited_(count_verts_), frontier_bits_(count_verts_), next_bits_(count_verts_),
+          local_frontiers_(count_threads_) {
+            frontier_.reserve(count_verts_);
+        }
+
+        void run(size_t root) {
+            if (root >= count_verts_)
+                throw error_t{"Invalid vertex index: " + std::to_string(root)};
+            if (!visited_.set(root))
+                return;
+
+            result_.levels [root] = 0;
+            result_.parents[root] = static_cast<index_t>(root);
+            count_visited_++;
+
+            frontier_.assign(1, static_cast<index_t>(root));
+            for (auto& local : local_frontiers_)
+                local.clear();
+            depth_ = 0;
+            is_bottom_up_ = false;
+            next_chunk_.store(0);
+
+            /* a thread that throws still arrives at the barrier, then all of them stop
+               at the same level and run_parallel rethrows; the result is unspecified then.
+               is_stopped, like frontier_, changes only between levels, so all threads see one value */
+            std::atomic<bool> is_failed = false;
+            bool is_stopped = false;
+            std::barrier sync{static_cast<std::ptrdiff_t>(count_threads_), [&]() noexcept {
+                is_stopped = is_failed.load(std::memory_order_relaxed);
+                if (!is_stopped)
+                    finish_level();
+            }};
+            run_parallel(count_threads_, [&](unsigned thread_index) {
+                std::exception_ptr error;
+                while (!frontier_.empty() && !is_stopped) {
+                    try {
+                        if (is_bottom_up_)
+                            bottom_up_step(thread_index);
+                        else
+                            top_down_step(thread_index);
+                    } catch (...) {
+                        error = std::current_exception();
+                        is_failed.store(true, std::memory_order_relaxed);
+                    }
+                    sync.arrive_and_wait();
+                }
+                if (error)
+                    std::rethrow_exception(error);
+            });
+        }
+
+        /* every root is traversed by a single thread, for many small components */
+        void run_local(std::span<const index_t> roots) {
+            std::atomic<size_t> next_root = 0;
+            std::atomic<size_t> count_visited = 0;
+
+            run_parallel(count_threads_, [&](unsigned) {
+                std::vector<index_t> queue;
+                size_t local_visited = 0;
+                for (size_t begin = next_root.fetch_add(CHUNK_SIZE); begin < roots.size();
+                            begin = next_root.fetch_add(CHUNK_SIZE)) {
+                    size_t end = std::min(begin + CHUNK_SIZE, roots.size());
+                    for (index_t root : roots.subspan(begin, end - begin)) {
+                        if (!visited_.set(root))
+                            continue;
+
+                        result_.levels [root] = 0;
+                        result_.parents[root] = root;
+                        queue.assign(1, root);
+                        for (size_t head = 0; head < queue.size(); ++head) {
+                            index_t u = queue[head];
+                            for (auto child : graph_->get_range_children({*graph_, u})) {
+                                index_t next = child.index();
+                                if (visited_.set(next)) {
+                                    result_.levels [next] = result_.levels[u] + 1;
+                                    result_.parents[next] = u;
+                                    queue.push_back(next);
+                                }
+                            }
+                        }
+                        local_visited += queue.size();
+                    }
+                }
+                count_visited += local_visited;
+            });
+            count_visited_ += count_visited;
+        }
+
+        bool is_visited(size_t vertex) const noexcept { return visited_.test(vertex); }
+
+        const result_t& result() const & noexcept { return result_; }
+              result_t  result()      && noexcept { return std::move(result_); }
+    };
+
+    template <typename GraphT>
+    inline parallel_bfs_result_t<typename GraphT::index_t>
+    do_parallel_bfs(const GraphT& graph, typename GraphT::const_iterator_t start,
+                    unsigned count_threads = default_count_threads()) {
+        parallel_bfs_t<GraphT> bfs{graph, count_threads};
+        bfs.run(start.index());
+        return std::move(bfs).result();
+    }
+}
\ No newline at end of file
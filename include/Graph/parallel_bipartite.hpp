@@ -0,0 +1,127 @@
+#pragma once
+
+#include "Graph/graph.hpp"
+#include "Graph/parallel_bfs.hpp"
+#include "Graph/union_find.hpp"
+
+#include <atomic>
+#include <vector>
+
+namespace graph {
+    namespace details {
+        /* BFS forest parents as get_odd_cycle expects them: roots point to count_verts + 1 */
+        template <typename IndexT>
+        struct forest_parents_t final {
+            const std::vector<IndexT>& parents;
+            size_t end_parent;
+
+            size_t operator[](size_t vertex) const noexcept {
+                return (parents[vertex] == vertex) ? end_parent : parents[vertex];
+            }
+        };
+    }
+
+    /* Same result as get_bipartite, computed by count_threads threads:
+       components are found with concurrent union-find, so every component is rooted
+       in its minimal vertex as in the sequential version and colors are equal to it.
+       Large components are colored by level parity of parallel BFS, small ones by
+       one thread each; then all edges are checked in parallel for equal colors.
+       With one thread it is get_bipartite itself, the extra passes do not pay off.
+       A relabeled graph is reported in original ids, as get_bipartite does. */
+    template <typename GraphT>
+    inline get_bipartite_result_t get_parallel_bipartite(const GraphT& graph,
+                                                        unsigned count_threads = default_count_threads()) {
+        using index_t = typename GraphT::index_t;
+        static constexpr size_t CHUNK_SIZE            = 1024;
+        static constexpr size_t LARGE_COMPONENT_SIZE  = 1 << 16;
+        static constexpr index_t NO_CONFLICT          = parallel_bfs_result_t<index_t>::NOT_VISITED;
+
+        if (count_threads <= 1)
+            return get_bipartite(graph);
+        GRAPH_STATS_TIMER("get_parallel_bipartite");
+
+        size_t count_verts = graph.count_verts();
+
+        auto for_each_chunk = [&](auto&& func) {
+            std::atomic<size_t> next_chunk = 0;
+            run_parallel(count_threads, [&](unsigned) {
+                for (size_t begin = next_chunk.fetch_add(CHUNK_SIZE); begin < count_verts;
+                            begin = next_chunk.fetch_add(CHUNK_SIZE))
+                    func(begin, std::min(begin + CHUNK_SIZE, count_verts));
+            });
+        };
+
+        concurrent_union_find_t<index_t> components{count_verts};
+        for_each_chunk([&](size_t begin, size_t end) {
+            for (size_t v = begin; v < end; ++v)
+                for (auto child : graph.get_range_children({graph, v}))
+                    if (child.index() < v)
+                        components.unite(static_cast<index_t>(v), child.index());
+        });
+
+        std::vector<std::atomic<index_t>> sizes(count_verts);
+        for_each_chunk([&](size_t begin, size_t end) {
+            for (size_t v = begin; v < end; ++v)
+                sizes[components.find(static_cast<index_t>(v))].fetch_add(1, std::memory_order_relaxed);
+        });
+
+        std::vector<index_t> small_roots;
+        parallel_bfs_t<GraphT> bfs{graph, count_threads};
+        for (size_t v = 0; v < count_verts; ++v) {
+            size_t size = sizes[v].load(std::memory_order_relaxed);
+            if (size >= LARGE_COMPONENT_SIZE)
+                bfs.run(v);
+            else if (size > 0)
+                small_roots.push_back(static_cast<index_t>(v));
+        }
+        bfs.run_local(small_roots);
+        GRAPH_STATS_ADD(vertexes_visited, count_verts);
+
+        const auto& levels = bfs.result().levels;
+        std::atomic<index_t> conflict_vertex = NO_CONFLICT;
+        std::atomic<index_t> conflict_child  = NO_CONFLICT;
+        for_each_chunk([&](size_t begin, size_t end) {
+            for (size_t v = begin; v < end; ++v) {
+                if (conflict_vertex.load(std::memory_order_relaxed) != NO_CONFLICT)
+                    return;
+
+                for (auto child : graph.get_range_children({graph, v})) {
+                    index_t next = child.index();
+                    if (((levels[v] ^ levels[next]) & 1) == 0) {
+                        index_t expected = NO_CONFLICT;
+                        if (conflict_vertex.compare_exchange_strong(expected, static_cast<index_t>(v)))
+                            conflict_child.store(next);
+                        return;
+                    }
+                }
+            }
+        });
+
+        if (conflict_vertex.load() != NO_CONFLICT) {
+            details::forest_parents_t<index_t> parents{bfs.result().parents, count_verts + 1};
+            return {false, {}, details::with_workspace<index_t>([&](auto& workspace) {
+                return details::get_original_odd_cycle(graph, conflict_vertex.load(), conflict_child.load(),
+                                                       parents, workspace);
+            })};
+        }
+
+        std::vector<int> colors(count_verts);
+        for_each_chunk([&](size_t begin, size_t end) {
+            for (size_t v = begin; v < end; ++v)
+                colors[v] = levels[v] & 1;
+        });
+
+        /* component of a relabeled graph is colored from its minimal original vertex */
+        if (details::is_relabeled(graph)) {
+            std::vector<int> root_colors(count_verts, -1);
+            for (size_t v = 0; v < count_verts; ++v) {
+                index_t u = static_cast<index_t>(internal_id(graph, v));
+                index_t root = components.find(u);
+                if (root_colors[root] == -1)
+                    root_colors[root] = colors[u];
+                colors[u] ^= root_colors[root];
+            }
+        }
+        return {true, details::get_original_colors(graph, std::move(colors)), {}};
+    }
+}
\ No newline at end of file
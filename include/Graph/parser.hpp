@@ -0,0 +1,340 @@
+#pragma once
+
+#include "Graph/common.hpp"
+#include "Graph/parallel.hpp"
+#include "Graph/stats.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <filesystem>
+#include <istream>
+#include <limits>
+#include <sstream>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace graph {
+    class mapped_file_t final {
+        void*  data_ = nullptr;
+        size_t size_ = 0;
+
+        void map(int fd, int advice) {
+            struct stat info;
+            if (fstat(fd, &info) != 0 || !S_ISREG(info.st_mode))
+                throw error_t{"Invalid input: file can not be mapped"};
+
+            size_ = static_cast<size_t>(info.st_size);
+            if (size_ == 0)
+                return;
+
+            data_ = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (data_ == MAP_FAILED) {
+                data_ = nullptr;
+                throw error_t{"Invalid input: mmap failed"};
+            }
+            madvise(data_, size_, advice);
+        }
+
+    public:
+        explicit mapped_file_t(int fd, int advice = MADV_SEQUENTIAL) { map(fd, advice); }
+
+        explicit mapped_file_t(const std::filesystem::path& path, int advice = MADV_SEQUENTIAL) {
+            int fd = open(path.c_str(), O_RDONLY);
+            if (fd < 0)
+                throw error_t{"Invalid input: can not open file: " + path.string()};
+
+            try {
+                map(fd, advice);
+            } catch (...) {
+                close(fd);
+                throw;
+            }
+            close(fd);
+        }
+
+        mapped_file_t(const mapped_file_t&) = delete;
+        mapped_file_t& operator=(const mapped_file_t&) = delete;
+
+        ~mapped_file_t() {
+            if (data_)
+                munmap(data_, size_);
+        }
+
+        std::string_view view() const noexcept {
+            return {static_cast<const char*>(data_), size_};
+        }
+
+        static bool is_mappable(int fd) noexcept {
+            struct stat info;
+            return fstat(fd, &info) == 0 && S_ISREG(info.st_mode);
+        }
+    };
+
+    /* Scanner of "a -- b" / "a -- b, w" edge lists over a contiguous buffer.
+       An edge does not span lines, so any chunk split at line ends parses the same.
+       Not final buffer may end inside of an edge: then parse() rolls back to the
+       beginning of this edge and reports it as incomplete. */
+    template <typename EdgeT>
+    class edge_parser_t final {
+    public:
+        using edge_t = std::tuple<size_t, size_t, EdgeT>;
+
+        enum class status_t { edge, end, incomplete };
+
+    private:
+        static constexpr bool with_info = not_monostate<EdgeT> && has_input_operator<EdgeT>;
+
+        const char* begin_;
+        const char* curr_;
+        const char* end_;
+        bool is_final_;
+
+        static bool is_space(char c) noexcept {
+            return c == ' ' || (c >= '\t' && c <= '\r');
+        }
+
+        bool skip_spaces() noexcept {
+            while (curr_ != end_ && is_space(*curr_))
+                ++curr_;
+            return curr_ != end_;
+        }
+
+        bool skip_line_spaces() noexcept {
+            while (curr_ != end_ && *curr_ != '\n' && is_space(*curr_))
+                ++curr_;
+            return curr_ != end_ && *curr_ != '\n';
+        }
+
+        template <typename T>
+        bool read_number(T& value) noexcept {
+            if constexpr (std::is_integral_v<T>) {
+                using unsigned_t = std::make_unsigned_t<T>;
+                constexpr unsigned_t MAX_VALUE = std::numeric_limits<T>::max();
+
+                bool is_negative = (*curr_ == '-');
+                if (is_negative && !std::is_signed_v<T>)
+                    return false;
+                if (is_negative || *curr_ == '+')
+                    ++curr_;
+
+                const char* start = curr_;
+                unsigned_t result = 0;
+                for (; curr_ != end_; ++curr_) {
+                    unsigned digit = static_cast<unsigned char>(*curr_) - '0';
+                    if (digit > 9)
+                        break;
+                    if (result > (MAX_VALUE - digit) / 10)
+                        return false;
+                    result = 10 * result + digit;
+                }
+
+                if (curr_ == start)
+                    return false;
+                value = is_negative ? static_cast<T>(-result) : static_cast<T>(result);
+                return true;
+            } else {
+                if (*curr_ == '+')
+                    ++curr_;
+
+                auto [ptr, ec] = std::from_chars(curr_, end_, value, std::chars_format::general);
+                if (ec != std::errc{})
+                    return false;
+                curr_ = ptr;
+                return true;
+            }
+        }
+
+        std::string_view read_token() noexcept {
+            const char* start = curr_;
+            while (curr_ != end_ && !is_space(*curr_))
+                ++curr_;
+            return {start, static_cast<size_t>(curr_ - start)};
+        }
+
+        bool read_info(EdgeT& info) {
+            if constexpr ((std::is_integral_v<EdgeT> && !std::is_same_v<EdgeT, bool>) ||
+                           std::is_floating_point_v<EdgeT>) {
+                return read_number(info);
+            } else {
+                std::istringstream iss{std::string{read_token()}};
+                return static_cast<bool>(iss >> info);
+            }
+        }
+
+    public:
+        edge_parser_t(std::string_view data, bool is_final = true)
+        : begin_(data.data()), curr_(data.data()), end_(data.data() + data.size()), is_final_(is_final) {}
+
+        size_t position() const noexcept { return curr_ - begin_; }
+
+        status_t parse(edge_t& edge) {
+            if (!skip_spaces())
+                return status_t::end;
+
+            const char* edge_begin = curr_;
+            auto truncated = [&](const char* message) {
+                if (is_final_ || curr_ != end_)
+                    throw error_t{message};
+                curr_ = edge_begin;
+                return status_t::incomplete;
+            };
+
+            long long v1_, v2_;
+            if (!read_number(v1_))
+                throw error_t{"Invalid edge indexes"};
+
+            if (!skip_line_spaces())
+                return truncated("Invalid edge indexes");
+            std::string_view dashes = read_token();
+
+            if (!skip_line_spaces())
+                return truncated("Invalid edge indexes");
+            if (!read_number(v2_))
+                throw error_t{"Invalid edge indexes"};
+
+            if (dashes != "--")
+                throw error_t{"Invalid input: expected dashes between vertex indexes, read: " +
+                              std::string{dashes}};
+            check_vertex_indexes(v1_, v2_);
+
+            EdgeT w_{};
+            if constexpr (with_info) {
+                if (!skip_line_spaces())
+                    return truncated("Invalid edge info");
+                char comma = *curr_++;
+
+                if (!skip_line_spaces())
+                    return truncated("Invalid edge info");
+                if (!read_info(w_))
+                    throw error_t{"Invalid edge info"};
+                if (comma != ',')
+                    throw error_t{std::string{"Invalid input: expected comma, read: "} + comma};
+            }
+
+            auto& [v1, v2, w] = edge;
+            v1 = static_cast<size_t>(v1_ - 1);
+            v2 = static_cast<size_t>(v2_ - 1);
+            w = std::move(w_);
+            return status_t::edge;
+        }
+    };
+
+    namespace details {
+        /* edge callback may return false to stop the parsing */
+        template <typename Func, typename EdgeT>
+        inline bool call_edge_func(Func& func, const EdgeT& edge) {
+            if constexpr (std::is_same_v<std::invoke_result_t<Func&, const EdgeT&>, bool>) {
+                return func(edge);
+            } else {
+                func(edge);
+                return true;
+            }
+        }
+    }
+
+    template <typename EdgeT, typename Func>
+    inline void for_each_edge(std::string_view data, Func&& func) {
+        using parser_t = edge_parser_t<EdgeT>;
+
+        parser_t parser{data};
+        typename parser_t::edge_t edge;
+        [[maybe_unused]] size_t count_edges = 0;
+        while (parser.parse(edge) == parser_t::status_t::edge) {
+            ++count_edges;
+            if (!details::call_edge_func(func, std::as_const(edge)))
+                break;
+        }
+        GRAPH_STATS_ADD(edges_parsed, count_edges);
+        GRAPH_STATS_ADD(bytes_read, parser.position());
+    }
+
+    template <typename EdgeT, typename Func>
+    inline void for_each_edge(std::istream& is, Func&& func) {
+        using parser_t = edge_parser_t<EdgeT>;
+        constexpr size_t BLOCK_SIZE = 1 << 20;
+
+        std::vector<char> buffer(BLOCK_SIZE);
+        size_t filled = 0;
+        typename parser_t::edge_t edge;
+        [[maybe_unused]] size_t count_edges = 0;
+        while (true) {
+            if (filled == buffer.size())
+                buffer.resize(2 * buffer.size());
+
+            is.read(buffer.data() + filled, buffer.size() - filled);
+            filled += static_cast<size_t>(is.gcount());
+            GRAPH_STATS_ADD(bytes_read, is.gcount());
+            bool is_final = !is;
+
+            std::string_view chunk{buffer.data(), filled};
+            if (!is_final) {
+                size_t last_line_end = chunk.rfind('\n');
+                if (last_line_end == std::string_view::npos)
+                    continue;
+                chunk = chunk.substr(0, last_line_end + 1);
+            }
+
+            bool is_stopped = false;
+            parser_t parser{chunk, is_final};
+            while (!is_stopped && parser.parse(edge) == parser_t::status_t::edge) {
+                ++count_edges;
+                is_stopped = !details::call_edge_func(func, std::as_const(edge));
+            }
+
+            if (is_final || is_stopped)
+                break;
+
+            size_t consumed = parser.position();
+            std::copy(buffer.begin() + consumed, buffer.begin() + filled, buffer.begin());
+            filled -= consumed;
+        }
+
+        GRAPH_STATS_ADD(edges_parsed, count_edges);
+        if (is.eof())
+            is.clear(std::ios::eofbit);
+    }
+
+    /* Splits data into chunks at line boundaries, parses them concurrently into
+       per-thread buffers and then calls func for every edge in input order.
+       Edges do not span lines, so the result and errors do not depend on the split. */
+    template <typename EdgeT, typename Func>
+    inline void for_each_edge(std::string_view data, Func&& func, unsigned count_threads) {
+        using edge_t = typename edge_parser_t<EdgeT>::edge_t;
+        constexpr size_t MIN_CHUNK_SIZE = 1 << 20;
+
+        size_t max_count_chunks = data.size() / MIN_CHUNK_SIZE + 1;
+        unsigned count_chunks = std::min<size_t>(std::max(count_threads, 1U), max_count_chunks);
+        if (count_chunks == 1)
+            return for_each_edge<EdgeT>(data, std::forward<Func>(func));
+
+        std::vector<size_t> bounds(count_chunks + 1, data.size());
+        bounds[0] = 0;
+        for (unsigned i = 1; i < count_chunks; ++i) {
+            size_t line_end = data.find('\n', std::max(bounds[i - 1], i * (data.size() / count_chunks)));
+            bounds[i] = (line_end == std::string_view::npos) ? data.size() : line_end + 1;
+        }
+
+        std::vector<std::vector<edge_t>> chunks(count_chunks);
+        run_parallel(count_chunks, [&](unsigned i) {
+            std::string_view chunk_data = data.substr(bounds[i], bounds[i + 1] - bounds[i]);
+            for_each_edge<EdgeT>(chunk_data, [&](const edge_t& edge) {
+                chunks[i].push_back(edge);
+            });
+        });
+
+        for (auto& chunk : chunks) {
+            for (auto& edge : chunk)
+                if (!details::call_edge_func(func, std::as_const(edge)))
+                    return;
+            std::vector<edge_t>{}.swap(chunk);
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "Graph/common.hpp"
+#include "Graph/stats.hpp"
+
+#include <algorithm>
+#include <numeric>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace graph {
+    enum class reorder_t { bfs, rcm, degree };
+
+    inline reorder_t parse_reorder(std::string_view name) {
+        if (name == "bfs")    return reorder_t::bfs;
+        if (name == "rcm")    return reorder_t::rcm;
+        if (name == "degree") return reorder_t::degree;
+        throw error_t{"Invalid reorder: " + std::string{name} + ", expected bfs, rcm or degree"};
+    }
+
+    /* Order of vertexes for relabel(), so neighbours get close ids:
+       bfs     - components in order of their minimal vertex, every one in BFS order;
+       rcm     - reverse Cuthill-McKee: BFS from a vertex of minimal degree,
+                 children in increasing degree, whole order reversed;
+       degree  - decreasing degree, hubs share the first cache lines. */
+    template <typename GraphT>
+    inline std::vector<typename GraphT::index_t> get_vertex_order(const GraphT& graph, reorder_t strategy) {
+        using index_t = typename GraphT::index_t;
+
+        size_t count_verts = graph.count_verts();
+        std::vector<index_t> degrees(count_verts, 0);
+        for (size_t v = 0; v < count_verts; ++v)
+            for ([[maybe_unused]] auto child : graph.get_range_children({graph, v}))
+                degrees[v]++;
+
+        std::vector<index_t> order(count_verts);
+        std::iota(order.begin(), order.end(), 0);
+        auto by_degree = [&](index_t v1, index_t v2) { return degrees[v1] < degrees[v2]; };
+
+        if (strategy == reorder_t::degree) {
+            std::ranges::stable_sort(order, [&](index_t v1, index_t v2) { return by_degree(v2, v1); });
+            return order;
+        }
+
+        std::vector<index_t> starts = std::move(order);
+        if (strategy == reorder_t::rcm)
+            std::ranges::stable_sort(starts, by_degree);
+
+        /* order is the queue of BFS as well */
+        order.clear();
+        order.reserve(count_verts);
+        std::vector<bool> is_visited(count_verts, false);
+        for (auto start : starts) {
+            if (is_visited[start])
+                continue;
+
+            is_visited[start] = true;
+            order.push_back(start);
+            for (size_t head = order.size() - 1; head < order.size(); ++head) {
+                size_t first_child = order.size();
+                for (auto child : graph.get_range_children({graph, order[head]})) {
+                    index_t next = child.index();
+                    if (!is_visited[next]) {
+                        is_visited[next] = true;
+                        order.push_back(next);
+                    }
+                }
+                if (strategy == reorder_t::rcm)
+                    std::stable_sort(order.begin() + first_child, order.end(), by_degree);
+            }
+        }
+
+        if (strategy == reorder_t::rcm)
+            std::ranges::reverse(order);
+        return order;
+    }
+
+    /* graph is relabeled in place, results of get_bipartite stay in original ids */
+    template <typename GraphT>
+    inline void reorder(GraphT& graph, reorder_t strategy) {
+        GRAPH_STATS_TIMER("reorder");
+        auto order = get_vertex_order(graph, strategy);
+        graph.relabel(order);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,356 @@
+#pragma once
+
+#include "Graph/common.hpp"
+#include "Graph/parallel.hpp"
+#include "Graph/stats.hpp"
+
+#include <algorithm>
+#include <array>
+#include <barrier>
+#include <bit>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace graph {
+    template <typename IndexT>
+    struct shortest_paths_result_t final {
+        static constexpr uint64_t NOT_REACHED = std::numeric_limits<uint64_t>::max();
+        static constexpr IndexT   NO_PARENT   = std::numeric_limits<IndexT>::max();
+
+        std::vector<uint64_t> distances;
+        /* predecessor tree, parent of start is start itself */
+        std::vector<IndexT> parents;
+
+        bool is_reachable(size_t vertex) const noexcept { return distances[vertex] != NOT_REACHED; }
+
+        /* vertexes from start to target, empty if target is not reachable */
+        std::vector<IndexT> get_path(size_t target) const {
+            std::vector<IndexT> path;
+            if (!is_reachable(target))
+                return path;
+
+            IndexT v = static_cast<IndexT>(target);
+            for (; parents[v] != v; v = parents[v])
+                path.push_back(v);
+            path.push_back(v);
+            std::ranges::reverse(path);
+            return path;
+        }
+    };
+
+    namespace details {
+        template <typename GraphT>
+        using weight_t = std::remove_cvref_t<decltype((*std::declval<typename GraphT::const_iterator_t>()).edge())>;
+
+        /* Monotone priority queue for integer keys: key goes to bucket of the highest bit
+           where it differs from the last popped key, so every item moves down O(log C) times. */
+        template <typename ValueT>
+        class radix_heap_t final {
+            using item_t = std::pair<uint64_t, ValueT>;
+            static constexpr size_t COUNT_BUCKETS = 65;
+
+            std::array<std::vector<item_t>, COUNT_BUCKETS> buckets_;
+            uint64_t last_ = 0;
+            size_t size_ = 0;
+
+            static size_t bucket_index(uint64_t key, uint64_t last) noexcept {
+                return key == last ? 0 : 64 - std::countl_zero(key ^ last);
+            }
+
+        public:
+            bool empty() const noexcept { return size_ == 0; }
+
+            /* key must not be less than the last popped one */
+            void push(uint64_t key, ValueT value) {
+                buckets_[bucket_index(key, last_)].emplace_back(key, value);
+                size_++;
+            }
+
+            item_t pop() {
+                if (buckets_[0].empty()) {
+                    size_t i = 1;
+                    while (buckets_[i].empty())
+                        ++i;
+
+                    last_ = std::ranges::min_element(buckets_[i])->first;
+                    for (auto& item : buckets_[i])
+                        buckets_[bucket_index(item.first, last_)].push_back(item);
+                    buckets_[i].clear();
+                }
+
+                item_t item = buckets_[0].back();
+                buckets_[0].pop_back();
+                size_--;
+                return item;
+            }
+        };
+
+        template <typename IndexT>
+        inline shortest_paths_result_t<IndexT> start_shortest_paths(size_t count_verts, size_t start) {
+            using result_t = shortest_paths_result_t<IndexT>;
+            if (start >= count_verts)
+                throw error_t{"Invalid vertex index: " + std::to_string(start)};
+
+            result_t result{std::vector<uint64_t>(count_verts, result_t::NOT_REACHED),
+                            std::vector<IndexT>  (count_verts, result_t::NO_PARENT)};
+            result.distances[start] = 0;
+            result.parents  [start] = static_cast<IndexT>(start);
+            return result;
+        }
+
+        inline error_t negative_weight_error(size_t u, size_t v) {
+            return error_t{"Negative weight of edge: " + std::to_string(u + 1) + " -- " + std::to_string(v + 1)};
+        }
+    }
+
+    /* Dijkstra over integer weights of edges with radix heap */
+    template <typename GraphT>
+    inline shortest_paths_result_t<typename GraphT::index_t>
+    get_shortest_paths(const GraphT& graph, typename GraphT::const_iterator_t start) {
+        using index_t = typename GraphT::index_t;
+        static_assert(std::is_integral_v<details::weight_t<GraphT>>, "Weights of edges must be integral");
+        GRAPH_STATS_TIMER("get_shortest_paths");
+
+        auto result = details::start_shortest_paths<index_t>(graph.count_verts(), start.index());
+        auto& distances = result.distances;
+
+        details::radix_heap_t<index_t> heap;
+        heap.push(0, start.index());
+        [[maybe_unused]] size_t count_visited = 0;
+        while (!heap.empty()) {
+            auto [distance, u] = heap.pop();
+            if (distance != distances[u])
+                continue;
+
+            count_visited++;
+            for (auto child : graph.get_range_children({graph, u})) {
+                auto weight = child.edge();
+                if (std::cmp_less(weight, 0))
+                    throw details::negative_weight_error(u, child.index());
+
+                uint64_t next_distance = distance + static_cast<uint64_t>(weight);
+                index_t next = child.index();
+                if (next_distance < distances[next]) {
+                    distances[next] = next_distance;
+                    result.parents[next] = u;
+                    heap.push(next_distance, next);
+                }
+            }
+        }
+        GRAPH_STATS_ADD(vertexes_visited, count_visited);
+        return result;
+    }
+
+    /* Delta-stepping (Meyer, Sanders): vertexes are split into buckets of width delta,
+       the minimal bucket is settled by rounds of light (weight <= delta) relaxations,
+       heavy edges of its vertexes are relaxed once after. Vertex v is owned by thread
+       v % count_threads, which alone writes its distance and keeps its buckets,
+       other threads send it requests, so rounds need no atomics. */
+    template <typename GraphT>
+    class delta_stepping_t final {
+        using index_t  = typename GraphT::index_t;
+        using result_t = shortest_paths_result_t<index_t>;
+
+        static constexpr uint64_t NO_BUCKET       = std::numeric_limits<uint64_t>::max();
+        static constexpr uint64_t MAX_COUNT_SLOTS = 1 << 16;
+
+        struct request_t final {
+            index_t  vertex;
+            index_t  parent;
+            uint64_t distance;
+        };
+
+        enum class step_t { light, heavy };
+
+    private:
+        const GraphT* graph_;
+        unsigned count_threads_;
+        uint64_t delta_ = 1;
+
+        result_t result_;
+
+        /* buckets_[owner][bucket % count_slots_], live buckets are at most max weight / delta + 1 apart */
+        size_t count_slots_ = 1;
+        std::vector<std::vector<std::vector<index_t>>> buckets_;
+        std::vector<std::vector<index_t>> settled_;
+        std::vector<std::vector<index_t>> frontiers_;
+        /* requests_[from * count_threads_ + to] */
+        std::vector<std::vector<request_t>> requests_;
+
+        std::vector<uint8_t>  has_current_;
+        std::vector<uint64_t> next_buckets_;
+        uint64_t current_ = 0;
+        step_t step_ = step_t::light;
+
+    private:
+        unsigned owner(size_t vertex) const noexcept { return vertex % count_threads_; }
+
+        std::vector<index_t>& bucket(unsigned thread_index, uint64_t number) {
+            return buckets_[thread_index][number % count_slots_];
+        }
+
+        void relax(index_t u, bool is_light, unsigned thread_index) {
+            uint64_t distance = result_.distances[u];
+            for (auto child : graph_->get_range_children({*graph_, u})) {
+                uint64_t weight = static_cast<uint64_t>(child.edge());
+                if ((weight <= delta_) != is_light)
+                    continue;
+
+                index_t next = child.index();
+                uint64_t next_distance = distance + weight;
+                if (next_distance < result_.distances[next])
+                    requests_[thread_index * count_threads_ + owner(next)].push_back({next, u, next_distance});
+            }
+        }
+
+        void relax_step(unsigned thread_index) {
+            auto& settled = settled_[thread_index];
+            if (step_ == step_t::heavy) {
+                std::ranges::sort(settled);
+                auto [end, _] = std::ranges::unique(settled);
+                for (auto it = settled.begin(); it != end; ++it)
+                    relax(*it, false, thread_index);
+                settled.clear();
+                return;
+            }
+
+            auto& frontier = frontiers_[thread_index];
+            frontier.swap(bucket(thread_index, current_));
+            bucket(thread_index, current_).clear();
+            std::ranges::sort(frontier);
+            auto [end, _] = std::ranges::unique(frontier);
+            for (auto it = frontier.begin(); it != end; ++it) {
+                if (result_.distances[*it] / delta_ != current_)
+                    continue;
+                settled.push_back(*it);
+                relax(*it, true, thread_index);
+            }
+            frontier.clear();
+        }
+
+        void apply_requests(unsigned thread_index) {
+            for (unsigned from = 0; from < count_threads_; ++from) {
+                auto& requests = requests_[from * count_threads_ + thread_index];
+                for (auto [vertex, parent, distance] : requests) {
+                    if (distance < result_.distances[vertex]) {
+                        result_.distances[vertex] = distance;
+                        result_.parents  [vertex] = parent;
+                        bucket(thread_index, distance / delta_).push_back(vertex);
+                    }
+                }
+                requests.clear();
+            }
+
+            has_current_[thread_index] = !bucket(thread_index, current_).empty();
+            next_buckets_[thread_index] = NO_BUCKET;
+            if (step_ == step_t::heavy) {
+                for (uint64_t number = current_ + 1; number < current_ + count_slots_; ++number) {
+                    if (!bucket(thread_index, number).empty()) {
+                        next_buckets_[thread_index] = number;
+                        break;
+                    }
+                }
+            }
+        }
+
+        /* runs on one thread between steps */
+        void finish_step() noexcept {
+            if (step_ == step_t::light) {
+                if (std::ranges::none_of(has_current_, [](uint8_t flag) { return flag != 0; }))
+                    step_ = step_t::heavy;
+                return;
+            }
+
+            step_ = step_t::light;
+            current_ = std::ranges::min(next_buckets_);
+        }
+
+        /* checks weights once before rounds, throwing in a round would leave others at barrier */
+        void prepare(size_t start) {
+            std::vector<uint64_t> max_weights(count_threads_, 0), degrees(count_threads_, 0);
+
+            run_parallel(count_threads_, [&](unsigned thread_index) {
+                size_t count_verts = graph_->count_verts();
+                for (size_t v = thread_index; v < count_verts; v += count_threads_) {
+                    for (auto child : graph_->get_range_children({*graph_, v})) {
+                        auto weight = child.edge();
+                        if (std::cmp_less(weight, 0))
+                            throw details::negative_weight_error(v, child.index());
+                        max_weights[thread_index] = std::max<uint64_t>(max_weights[thread_index], weight);
+                        degrees[thread_index]++;
+                    }
+                }
+            });
+
+            uint64_t max_weight = std::ranges::max(max_weights);
+            uint64_t sum_degrees = 0;
+            for (auto degree : degrees)
+                sum_degrees += degree;
+
+            if (delta_ == 0) {
+                uint64_t average_degree = std::max<uint64_t>(sum_degrees / std::max<size_t>(graph_->count_verts(), 1), 1);
+                delta_ = std::max<uint64_t>(max_weight / average_degree, 1);
+            }
+            /* more slots only make heavy steps scan empty buckets, so a small delta
+               for large weights is raised until max weight / delta + 2 slots fit */
+            if (max_weight / delta_ + 2 > MAX_COUNT_SLOTS)
+                delta_ = (max_weight + MAX_COUNT_SLOTS - 3) / (MAX_COUNT_SLOTS - 2);
+            count_slots_ = max_weight / delta_ + 2;
+            for (auto& buckets : buckets_)
+                buckets.resize(count_slots_);
+
+            bucket(owner(start), 0).push_back(static_cast<index_t>(start));
+        }
+
+    public:
+        /* delta == 0 takes max weight / average degree, delta() is the one used by run() */
+        delta_stepping_t(const GraphT& graph, uint64_t delta = 0, unsigned count_threads = default_count_threads())
+        : graph_(&graph), count_threads_(std::max(count_threads, 1U)), delta_(delta),
+          buckets_(count_threads_), settled_(count_threads_), frontiers_(count_threads_),
+          requests_(count_threads_ * count_threads_),
+          has_current_(count_threads_, 0), next_buckets_(count_threads_, NO_BUCKET) {}
+
+        void run(size_t start) {
+            result_ = details::start_shortest_paths<index_t>(graph_->count_verts(), start);
+            prepare(start);
+            current_ = 0;
+            step_ = step_t::light;
+
+            std::barrier relax_sync{static_cast<std::ptrdiff_t>(count_threads_)};
+            std::barrier step_sync {static_cast<std::ptrdiff_t>(count_threads_), [this]() noexcept { finish_step(); }};
+            run_parallel(count_threads_, [&](unsigned thread_index) {
+                while (current_ != NO_BUCKET) {
+                    relax_step(thread_index);
+                    relax_sync.arrive_and_wait();
+                    apply_requests(thread_index);
+                    step_sync.arrive_and_wait();
+                }
+            });
+        }
+
+        uint64_t delta() const noexcept { return delta_; }
+
+        const result_t& result() const & noexcept { return result_; }
+              result_t  result()      && noexcept { return std::move(result_); }
+    };
+
+    /* Same distances as get_shortest_paths, parents may differ between equal paths */
+    template <typename GraphT>
+    inline shortest_paths_result_t<typename GraphT::index_t>
+    get_parallel_shortest_paths(const GraphT& graph, typename GraphT::const_iterator_t start, uint64_t delta = 0,
+                                unsigned count_threads = default_count_threads()) {
+        static_assert(std::is_integral_v<details::weight_t<GraphT>>, "Weights of edges must be integral");
+        if (count_threads <= 1)
+            return get_shortest_paths(graph, start);
+
+        GRAPH_STATS_TIMER("get_parallel_shortest_paths");
+        delta_stepping_t<GraphT> delta_stepping{graph, delta, count_threads};
+        delta_stepping.run(start.index());
+        GRAPH_STATS_ADD(vertexes_visited, graph.count_verts());
+        return std::move(delta_stepping).result();
+    }
+}
\ No newline at end of file
@@ -0,0 +1,315 @@
+#pragma once
+
+#include "Graph/common.hpp"
+#include "Graph/parser.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <limits>
+#include <memory>
+#include <ostream>
+#include <span>
+#include <type_traits>
+#include <variant>
+
+namespace graph {
+    template <typename VertexT, typename EdgeT, typename IndexT>
+    concept snapshotable = std::is_trivially_copyable_v<VertexT> &&
+                           std::is_trivially_copyable_v<EdgeT>   &&
+                           std::is_trivially_copyable_v<IndexT>;
+
+    /* Binary layout: header, then v_data, e_data, edges, next arrays,
+       each one starts at ALIGNMENT boundary, so they are used in place */
+    struct snapshot_header_t final {
+        static constexpr std::array<char, 8> MAGIC      = {'G', 'R', 'A', 'P', 'H', 'S', 'N', 'P'};
+        static constexpr uint32_t            VERSION    = 1;
+        static constexpr uint32_t            ENDIAN_TAG = 0x01020304;
+        static constexpr size_t              ALIGNMENT  = 64;
+
+        std::array<char, 8> magic;
+        uint32_t version;
+        uint32_t endian_tag;
+        uint32_t vertex_size;
+        uint32_t edge_size;
+        uint32_t index_size;
+        uint32_t reserved;
+        uint64_t count_verts;
+        uint64_t count_edges;
+        uint64_t v_data_offset;
+        uint64_t e_data_offset;
+        uint64_t edges_offset;
+        uint64_t next_offset;
+        uint64_t file_size;
+
+        static uint64_t align(uint64_t offset) noexcept {
+            return (offset + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+        }
+
+        template <typename VertexT, typename EdgeT, typename IndexT>
+        static snapshot_header_t create(size_t count_verts, size_t count_edges) {
+            snapshot_header_t header{};
+            header.magic       = MAGIC;
+            header.version     = VERSION;
+            header.endian_tag  = ENDIAN_TAG;
+            header.vertex_size = sizeof(VertexT);
+            header.edge_size   = sizeof(EdgeT);
+            header.index_size  = sizeof(IndexT);
+            header.count_verts = count_verts;
+            header.count_edges = count_edges;
+
+            header.v_data_offset = align(sizeof(snapshot_header_t));
+            header.e_data_offset = align(header.v_data_offset + count_verts * sizeof(VertexT));
+            header.edges_offset  = align(header.e_data_offset + count_edges * sizeof(EdgeT));
+            header.next_offset   = align(header.edges_offset  + 2 * count_edges * sizeof(IndexT));
+            header.file_size     = header.next_offset + (count_verts + 2 * count_edges) * sizeof(IndexT);
+            return header;
+        }
+
+        template <typename VertexT, typename EdgeT, typename IndexT>
+        void validate(size_t real_file_size) const {
+            if (magic != MAGIC)
+                throw error_t{"Invalid snapshot: wrong magic"};
+            if (version != VERSION)
+                throw error_t{"Invalid snapshot: unsupported version: " + std::to_string(version)};
+            if (endian_tag != ENDIAN_TAG)
+                throw error_t{"Invalid snapshot: byte order differs from host"};
+            if (vertex_size != sizeof(VertexT) || edge_size != sizeof(EdgeT) || index_size != sizeof(IndexT))
+                throw error_t{"Invalid snapshot: vertex, edge or index type size mismatch"};
+
+            /* next array alone takes an index per vertex and arc, so layout below does not overflow */
+            if (count_verts > real_file_size / sizeof(IndexT) || count_edges > real_file_size / sizeof(IndexT))
+                throw error_t{"Invalid snapshot: corrupted layout"};
+            if (count_verts + 2 * count_edges >= std::numeric_limits<IndexT>::max())
+                throw error_t{"Invalid snapshot: graph does not fit index type"};
+
+            auto expected = create<VertexT, EdgeT, IndexT>(count_verts, count_edges);
+            if (v_data_offset != expected.v_data_offset || e_data_offset != expected.e_data_offset ||
+                edges_offset  != expected.edges_offset  || next_offset   != expected.next_offset   ||
+                file_size     != expected.file_size     || real_file_size < file_size)
+                throw error_t{"Invalid snapshot: corrupted layout"};
+        }
+    };
+
+    /* std::monostate payloads are passed as empty spans, their bytes are written as zeros */
+    template <typename VertexT, typename EdgeT, typename IndexT>
+    requires snapshotable<VertexT, EdgeT, IndexT>
+    inline std::ostream& write_snapshot(std::ostream& os, size_t count_verts, size_t count_edges,
+                                        std::span<const VertexT> v_data, std::span<const EdgeT> e_data,
+                                        std::span<const IndexT>  edges,  std::span<const IndexT> next) {
+        auto header = snapshot_header_t::create<VertexT, EdgeT, IndexT>(count_verts, count_edges);
+
+        uint64_t position = 0;
+        auto write_bytes = [&](const void* data, size_t size) {
+            os.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+            position += size;
+        };
+        auto write_zeros = [&](size_t size) {
+            static const std::array<char, 4096> zeros{};
+            for (size_t chunk = 0; size > 0; size -= chunk) {
+                chunk = std::min(size, zeros.size());
+                write_bytes(zeros.data(), chunk);
+            }
+        };
+        auto write_array = [&](uint64_t offset, auto array, size_t count) {
+            write_zeros(offset - position);
+            if (array.empty())
+                write_zeros(count * sizeof(array[0]));
+            else
+                write_bytes(array.data(), array.size_bytes());
+        };
+
+        write_bytes(&header, sizeof(header));
+        write_array(header.v_data_offset, v_data, count_verts);
+        write_array(header.e_data_offset, e_data, count_edges);
+        write_array(header.edges_offset,  edges,  2 * count_edges);
+        write_array(header.next_offset,   next,   count_verts + 2 * count_edges);
+
+        if (!os)
+            throw error_t{"Invalid snapshot: write failed"};
+        return os;
+    }
+
+    /* Read-only graph over a mapped snapshot, arrays are used in place without copying.
+       Has the same const interface as graph_t, so traversals run on it unchanged. */
+    template <typename VertexT = std::monostate, typename EdgeT = std::monostate, typename IndexT = size_t>
+    requires snapshotable<VertexT, EdgeT, IndexT>
+    class graph_snapshot_t final {
+    public:
+        using index_t = IndexT;
+
+    private:
+        std::unique_ptr<mapped_file_t> file_;
+
+        size_t count_verts_ = 0;
+        size_t count_edges_ = 0;
+
+        std::span<const VertexT> v_data_;
+        std::span<const EdgeT>   e_data_;
+        std::span<const IndexT>  edges_;
+        std::span<const IndexT>  next_;
+
+    private:
+        class iterator_data_t final {
+            const VertexT* vertex_;
+            const EdgeT*   edge_;
+            IndexT         index_;
+
+        public:
+            iterator_data_t(const VertexT& vertex, const EdgeT& edge, IndexT index)
+            : vertex_(&vertex), edge_(&edge), index_(index) {}
+
+            const VertexT& vertex() const { return *vertex_; }
+            const EdgeT&   edge()   const { return *edge_; }
+
+            IndexT index() const noexcept { return index_; }
+        };
+
+        class internal_iterator_t final {
+            struct arrow_proxy final {
+                iterator_data_t reference;
+
+            public:
+                arrow_proxy(const iterator_data_t& reference_) : reference(reference_) {}
+                const iterator_data_t *operator->() const { return &reference; }
+            };
+
+        private:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type        = iterator_data_t;
+            using reference         = iterator_data_t;
+            using pointer           = arrow_proxy;
+            using difference_type   = std::ptrdiff_t;
+
+            const graph_snapshot_t* graph_;
+            IndexT index_;
+            IndexT count_verts_;
+
+        public:
+            internal_iterator_t(const graph_snapshot_t& graph, size_t index)
+            : graph_(&graph), index_(static_cast<IndexT>(index)),
+              count_verts_(static_cast<IndexT>(graph.count_verts())) {}
+
+            IndexT index() const noexcept { return index_; }
+
+            reference operator*() const {
+                IndexT e_index = index_ - count_verts_;
+                IndexT vertex = graph_->edges_[e_index];
+                IndexT edge = e_index ^ 1;
+
+                return {graph_->v_data_[vertex],
+                        graph_->e_data_[edge / 2],
+                        graph_->edges_[edge]};
+            }
+
+            pointer operator->() const noexcept { return **this; }
+
+            bool operator==(const internal_iterator_t& other) const noexcept {
+                return ((graph_ == other.graph_) && (index_ == other.index_));
+            }
+
+            bool operator!=(const internal_iterator_t& other) const noexcept {
+                return !(*this == other);
+            }
+
+            internal_iterator_t& operator++() noexcept {
+                index_ = graph_->next_[index_];
+                return *this;
+            }
+        };
+
+    public:
+        using const_iterator_t = internal_iterator_t;
+        using       iterator_t = internal_iterator_t;
+
+    private:
+        class range_children_t final {
+            const graph_snapshot_t* graph_;
+            IndexT start_index_;
+
+        public:
+            range_children_t(const graph_snapshot_t& graph, IndexT start_index)
+            : graph_(&graph), start_index_(start_index) {}
+
+            const_iterator_t begin() const { return ++const_iterator_t{*graph_, start_index_}; }
+            const_iterator_t end()   const { return   const_iterator_t{*graph_, start_index_}; }
+        };
+
+        template <typename T>
+        std::span<const T> get_array(uint64_t offset, size_t size) const {
+            const char* base = file_->view().data() + offset;
+            return {reinterpret_cast<const T*>(base), size};
+        }
+
+    public:
+        graph_snapshot_t() {}
+
+        /* header is always checked, is_verified skips the pass over adjacency lists,
+           for trusted files only */
+        explicit graph_snapshot_t(const std::filesystem::path& path, bool is_verified = false)
+        : file_(std::make_unique<mapped_file_t>(path, MADV_WILLNEED)) {
+            std::string_view data = file_->view();
+            GRAPH_STATS_ADD(bytes_read, data.size());
+
+            snapshot_header_t header;
+            if (data.size() < sizeof(header))
+                throw error_t{"Invalid snapshot: file is too small"};
+            std::memcpy(&header, data.data(), sizeof(header));
+            header.validate<VertexT, EdgeT, IndexT>(data.size());
+
+            count_verts_ = header.count_verts;
+            count_edges_ = header.count_edges;
+
+            v_data_ = get_array<VertexT>(header.v_data_offset, count_verts_);
+            e_data_ = get_array<EdgeT>  (header.e_data_offset, count_edges_);
+            edges_  = get_array<IndexT> (header.edges_offset,  2 * count_edges_);
+            next_   = get_array<IndexT> (header.next_offset,   count_verts_ + 2 * count_edges_);
+
+            if (!is_verified)
+                verify();
+        }
+
+        /* every vertex header starts a list of its own arcs returning to the header,
+           so iterators never read out of the arrays and every walk ends */
+        void verify() const {
+            if (!std::ranges::all_of(edges_, [&](IndexT vertex) { return vertex < count_verts_; }))
+                throw error_t{"Invalid snapshot: edge end out of range"};
+
+            size_t count_slots  = count_verts_ + 2 * count_edges_;
+            size_t count_walked = 0;
+            for (size_t v = 0; v < count_verts_; ++v) {
+                for (size_t i = next_[v]; i != v; i = next_[i]) {
+                    if (i < count_verts_ || i >= count_slots || edges_[i - count_verts_] != v ||
+                        ++count_walked > 2 * count_edges_)
+                        throw error_t{"Invalid snapshot: corrupted adjacency list of vertex " + std::to_string(v)};
+                }
+            }
+            if (count_walked != 2 * count_edges_)
+                throw error_t{"Invalid snapshot: arcs out of adjacency lists"};
+        }
+
+        const VertexT& get_vertex_info(const_iterator_t iterator) const {
+            size_t index = iterator.index();
+            if (index >= count_verts_)
+                throw error_t{"Invalid vertex index: " + std::to_string(index)};
+            return v_data_[index];
+        }
+
+        std::pair<size_t, size_t> get_edge_verts(size_t edge_index) const {
+            return {edges_[2 * edge_index], edges_[2 * edge_index + 1]};
+        }
+
+        const EdgeT& get_edge_info(size_t edge_index) const {
+            return e_data_[edge_index];
+        }
+
+        range_children_t get_range_children(const_iterator_t iterator) const {
+            return range_children_t{*this, iterator.index()};
+        }
+
+        size_t count_verts() const noexcept { return count_verts_; }
+        size_t count_edges() const noexcept { return count_edges_; }
+    };
+}
\ No newline at end of file
@@ -0,0 +1,186 @@
+#pragma once
+
+#include "Graph/common.hpp"
+#include "Graph/parallel.hpp"
+#include "Graph/stats.hpp"
+#include "Graph/union_find.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace graph {
+    template <typename IndexT, typename WeightT>
+    struct spanning_forest_result_t final {
+        using weight_sum_t = std::conditional_t<std::is_integral_v<WeightT>, int64_t, double>;
+
+        /* indexes of edges for get_edge_verts / get_edge_info, in increasing order */
+        std::vector<IndexT> edges;
+        weight_sum_t weight = 0;
+    };
+
+    namespace details {
+        template <typename GraphT>
+        using edge_weight_t = std::remove_cvref_t<decltype(std::declval<const GraphT&>().get_edge_info(0))>;
+
+        template <typename GraphT>
+        using spanning_forest_result_t = graph::spanning_forest_result_t<typename GraphT::index_t, edge_weight_t<GraphT>>;
+
+        /* graphs without online updates have no removed edges */
+        template <typename GraphT>
+        inline size_t count_edge_slots(const GraphT& graph) {
+            if constexpr (requires { graph.count_edge_slots(); })
+                return graph.count_edge_slots();
+            else
+                return graph.count_edges();
+        }
+
+        template <typename GraphT>
+        inline bool is_forest_candidate(const GraphT& graph, size_t edge_index) {
+            if constexpr (requires { graph.is_edge_removed(edge_index); })
+                if (graph.is_edge_removed(edge_index))
+                    return false;
+            auto [v1, v2] = graph.get_edge_verts(edge_index);
+            return v1 != v2;
+        }
+
+        template <typename GraphT>
+        inline void finish_spanning_forest(const GraphT& graph, spanning_forest_result_t<GraphT>& result) {
+            std::ranges::sort(result.edges);
+            for (auto edge_index : result.edges)
+                result.weight += graph.get_edge_info(edge_index);
+        }
+    }
+
+    /* Kruskal: edges sorted by (weight, index), so the forest is the unique minimal one
+       with ties broken by smaller index, get_parallel_spanning_forest returns the same */
+    template <typename GraphT>
+    inline details::spanning_forest_result_t<GraphT> get_spanning_forest(const GraphT& graph) {
+        using index_t  = typename GraphT::index_t;
+        using weight_t = details::edge_weight_t<GraphT>;
+        static_assert(std::is_arithmetic_v<weight_t>, "Weights of edges must be arithmetic");
+        GRAPH_STATS_TIMER("get_spanning_forest");
+
+        std::vector<std::pair<weight_t, index_t>> edges;
+        size_t count_slots = details::count_edge_slots(graph);
+        edges.reserve(count_slots);
+        for (size_t e = 0; e < count_slots; ++e)
+            if (details::is_forest_candidate(graph, e))
+                edges.emplace_back(graph.get_edge_info(e), static_cast<index_t>(e));
+        std::ranges::sort(edges);
+
+        details::spanning_forest_result_t<GraphT> result;
+        concurrent_union_find_t<index_t> components{graph.count_verts()};
+        for (auto [_, edge_index] : edges) {
+            auto [v1, v2] = graph.get_edge_verts(edge_index);
+            if (components.unite(static_cast<index_t>(v1), static_cast<index_t>(v2)))
+                result.edges.push_back(edge_index);
+        }
+        details::finish_spanning_forest(graph, result);
+        return result;
+    }
+
+    /* Boruvka: every round each component picks its minimal edge by (weight, index)
+       in parallel, picked edges are contracted with concurrent union-find and edges
+       inside one component are dropped, so rounds shrink both vertexes and edges.
+       With one thread it is get_spanning_forest itself. */
+    template <typename GraphT>
+    inline details::spanning_forest_result_t<GraphT>
+    get_parallel_spanning_forest(const GraphT& graph, unsigned count_threads = default_count_threads()) {
+        using index_t  = typename GraphT::index_t;
+        using weight_t = details::edge_weight_t<GraphT>;
+        static_assert(std::is_arithmetic_v<weight_t>, "Weights of edges must be arithmetic");
+        static constexpr size_t  CHUNK_SIZE = 4096;
+        static constexpr index_t NO_EDGE    = std::numeric_limits<index_t>::max();
+
+        if (count_threads <= 1)
+            return get_spanning_forest(graph);
+        GRAPH_STATS_TIMER("get_parallel_spanning_forest");
+
+        auto for_each_chunk = [&](size_t count, auto&& func) {
+            std::atomic<size_t> next_chunk = 0;
+            run_parallel(count_threads, [&](unsigned thread_index) {
+                for (size_t begin = next_chunk.fetch_add(CHUNK_SIZE); begin < count;
+                            begin = next_chunk.fetch_add(CHUNK_SIZE))
+                    func(begin, std::min(begin + CHUNK_SIZE, count), thread_index);
+            });
+        };
+
+        auto is_lighter = [&](index_t e1, index_t e2) {
+            const weight_t& w1 = graph.get_edge_info(e1);
+            const weight_t& w2 = graph.get_edge_info(e2);
+            return w1 < w2 || (w1 == w2 && e1 < e2);
+        };
+
+        size_t count_verts = graph.count_verts();
+        concurrent_union_find_t<index_t> components{count_verts};
+        std::vector<std::atomic<index_t>> lightest(count_verts);
+        for (auto& edge_index : lightest)
+            edge_index.store(NO_EDGE, std::memory_order_relaxed);
+
+        /* edges between different components, first round takes all slots */
+        std::vector<index_t> edges;
+        std::vector<std::vector<index_t>> local_edges(count_threads);
+        std::vector<std::vector<index_t>> local_forest(count_threads);
+        auto gather = [](std::vector<std::vector<index_t>>& locals, std::vector<index_t>& out) {
+            for (auto& local : locals) {
+                out.insert(out.end(), local.begin(), local.end());
+                local.clear();
+            }
+        };
+
+        for_each_chunk(details::count_edge_slots(graph), [&](size_t begin, size_t end, unsigned thread_index) {
+            for (size_t e = begin; e < end; ++e)
+                if (details::is_forest_candidate(graph, e))
+                    local_edges[thread_index].push_back(static_cast<index_t>(e));
+        });
+        gather(local_edges, edges);
+
+        details::spanning_forest_result_t<GraphT> result;
+        while (!edges.empty()) {
+            for_each_chunk(edges.size(), [&](size_t begin, size_t end, unsigned) {
+                for (size_t i = begin; i < end; ++i) {
+                    index_t edge_index = edges[i];
+                    auto [v1, v2] = graph.get_edge_verts(edge_index);
+                    for (index_t root : {components.find(static_cast<index_t>(v1)),
+                                         components.find(static_cast<index_t>(v2))}) {
+                        index_t current = lightest[root].load(std::memory_order_relaxed);
+                        while ((current == NO_EDGE || is_lighter(edge_index, current)) &&
+                               !lightest[root].compare_exchange_weak(current, edge_index, std::memory_order_relaxed)) {}
+                    }
+                }
+            });
+
+            /* picked edges form a forest as the order is strict, every one unites once */
+            for_each_chunk(count_verts, [&](size_t begin, size_t end, unsigned thread_index) {
+                for (size_t v = begin; v < end; ++v) {
+                    index_t edge_index = lightest[v].exchange(NO_EDGE, std::memory_order_relaxed);
+                    if (edge_index == NO_EDGE)
+                        continue;
+
+                    auto [v1, v2] = graph.get_edge_verts(edge_index);
+                    if (components.unite(static_cast<index_t>(v1), static_cast<index_t>(v2)))
+                        local_forest[thread_index].push_back(edge_index);
+                }
+            });
+            gather(local_forest, result.edges);
+
+            for_each_chunk(edges.size(), [&](size_t begin, size_t end, unsigned thread_index) {
+                for (size_t i = begin; i < end; ++i) {
+                    auto [v1, v2] = graph.get_edge_verts(edges[i]);
+                    if (components.find(static_cast<index_t>(v1)) != components.find(static_cast<index_t>(v2)))
+                        local_edges[thread_index].push_back(edges[i]);
+                }
+            });
+            edges.clear();
+            gather(local_edges, edges);
+        }
+
+        details::finish_spanning_forest(graph, result);
+        return result;
+    }
+}
\ No newline at end of file
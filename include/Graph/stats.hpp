@@ -0,0 +1,157 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <mutex>
+#include <ostream>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace graph::stats {
+    enum class counter_t {
+        edges_parsed,
+        bytes_read,
+        vertexes_visited,
+        queue_high_water,
+        allocations,
+        allocated_bytes,
+        count
+    };
+
+    inline constexpr std::array<std::string_view, static_cast<size_t>(counter_t::count)> COUNTER_NAMES{
+        "edges_parsed", "bytes_read", "vertexes_visited", "queue_high_water", "allocations", "allocated_bytes"
+    };
+
+    /* Process-wide phase times and counters. Library code reaches it only through
+       GRAPH_STATS_* macros, they are empty unless GRAPH_STATS is defined. Counters are
+       relaxed atomics added once per call or component, not per edge. Until
+       set_enabled(true) every update is one relaxed load of the flag. */
+    class registry_t final {
+        using clock_t = std::chrono::steady_clock;
+
+        std::array<std::atomic<uint64_t>, static_cast<size_t>(counter_t::count)> counters_{};
+        std::atomic<bool> is_enabled_ = false;
+
+        mutable std::mutex mutex_;
+        std::vector<std::pair<std::string_view, clock_t::duration>> phases_;
+
+        registry_t() = default;
+
+    public:
+        static registry_t& instance() {
+            static registry_t registry;
+            return registry;
+        }
+
+        bool is_enabled() const noexcept { return is_enabled_.load(std::memory_order_relaxed); }
+        void set_enabled(bool is_enabled) noexcept { is_enabled_.store(is_enabled, std::memory_order_relaxed); }
+
+        void add(counter_t counter, uint64_t value) noexcept {
+            if (!is_enabled())
+                return;
+            counters_[static_cast<size_t>(counter)].fetch_add(value, std::memory_order_relaxed);
+        }
+
+        void update_max(counter_t counter, uint64_t value) noexcept {
+            if (!is_enabled())
+                return;
+            auto& current = counters_[static_cast<size_t>(counter)];
+            uint64_t old = current.load(std::memory_order_relaxed);
+            while (old < value && !current.compare_exchange_weak(old, value, std::memory_order_relaxed)) {}
+        }
+
+        uint64_t get(counter_t counter) const noexcept {
+            return counters_[static_cast<size_t>(counter)].load(std::memory_order_relaxed);
+        }
+
+        /* phases keep the order of their first finish, repeated ones are summed */
+        void add_phase(std::string_view name, clock_t::duration duration) {
+            if (!is_enabled())
+                return;
+            std::lock_guard lock{mutex_};
+            for (auto& [phase_name, phase_duration] : phases_) {
+                if (phase_name == name) {
+                    phase_duration += duration;
+                    return;
+                }
+            }
+            phases_.emplace_back(name, duration);
+        }
+
+        double get_phase_ms(std::string_view name) const {
+            std::lock_guard lock{mutex_};
+            for (auto& [phase_name, phase_duration] : phases_)
+                if (phase_name == name)
+                    return std::chrono::duration<double, std::milli>(phase_duration).count();
+            return 0;
+        }
+
+        void reset() {
+            std::lock_guard lock{mutex_};
+            phases_.clear();
+            for (auto& counter : counters_)
+                counter.store(0, std::memory_order_relaxed);
+        }
+
+        /* one line: {"enabled":..,"phases_ms":{..},"counters":{..}} */
+        std::ostream& write_json(std::ostream& os) const {
+            bool is_enabled = false;
+#ifdef GRAPH_STATS
+            is_enabled = this->is_enabled();
+#endif
+            std::lock_guard lock{mutex_};
+            std::ios_base::fmtflags flags = os.flags();
+            std::streamsize precision = os.precision();
+            os << "{\"enabled\":" << (is_enabled ? "true" : "false") << ",\"phases_ms\":{";
+            for (size_t i = 0; i < phases_.size(); ++i)
+                os << (i ? "," : "") << '"' << phases_[i].first << "\":" << std::fixed << std::setprecision(3)
+                   << std::chrono::duration<double, std::milli>(phases_[i].second).count();
+
+            os << "},\"counters\":{";
+            for (size_t i = 0; i < counters_.size(); ++i)
+                os << (i ? "," : "") << '"' << COUNTER_NAMES[i] << "\":" << counters_[i].load(std::memory_order_relaxed);
+            os << "}}";
+            os.flags(flags);
+            os.precision(precision);
+            return os;
+        }
+    };
+
+    /* name must outlive the registry, string literals are expected */
+    class scoped_timer_t final {
+        std::string_view name_;
+        bool is_enabled_ = registry_t::instance().is_enabled();
+        std::chrono::steady_clock::time_point start_ = is_enabled_ ? std::chrono::steady_clock::now()
+                                                                   : std::chrono::steady_clock::time_point{};
+
+    public:
+        explicit scoped_timer_t(std::string_view name) : name_(name) {}
+        scoped_timer_t(const scoped_timer_t&) = delete;
+        scoped_timer_t& operator=(const scoped_timer_t&) = delete;
+
+        ~scoped_timer_t() {
+            if (is_enabled_)
+                registry_t::instance().add_phase(name_, std::chrono::steady_clock::now() - start_);
+        }
+    };
+}
+
+#ifdef GRAPH_STATS
+    #define GRAPH_STATS_CONCAT_IMPL(a, b) a##b
+    #define GRAPH_STATS_CONCAT(a, b) GRAPH_STATS_CONCAT_IMPL(a, b)
+
+    #define GRAPH_STATS_TIMER(name) \
+        graph::stats::scoped_timer_t GRAPH_STATS_CONCAT(graph_stats_timer_, __LINE__){name}
+    #define GRAPH_STATS_ADD(counter, value) \
+        graph::stats::registry_t::instance().add(graph::stats::counter_t::counter, value)
+    #define GRAPH_STATS_MAX(counter, value) \
+        graph::stats::registry_t::instance().update_max(graph::stats::counter_t::counter, value)
+#else
+    #define GRAPH_STATS_TIMER(name)         static_cast<void>(0)
+    #define GRAPH_STATS_ADD(counter, value) static_cast<void>(0)
+    #define GRAPH_STATS_MAX(counter, value) static_cast<void>(0)
+#endif
\ No newline at end of file
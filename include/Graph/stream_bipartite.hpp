@@ -0,0 +1,149 @@
+#pragma once
+
+#include "Graph/graph.hpp"
+#include "Graph/union_find.hpp"
+
+#include <limits>
+#include <numeric>
+#include <sstream>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace graph {
+    /* Bipartiteness of an edge stream in O(V) memory: edges are not stored, every edge
+       only adds "different colors" constraint into parity union-find. With certificate
+       the joining edges (spanning forest, at most V - 1) are kept, so the odd cycle is
+       found in the forest without a second pass over the input.
+       Paired with graph_t::add_edge it keeps bipartiteness of a growing graph,
+       every inserted edge costs near-constant time. */
+    template <typename IndexT = size_t>
+    class stream_bipartite_t final {
+        static_assert(std::is_unsigned_v<IndexT>, "IndexT must be an unsigned integral type");
+        static constexpr size_t MAX_INDEX = std::numeric_limits<IndexT>::max();
+        using unite_status_t = typename parity_union_find_t<IndexT>::unite_status_t;
+
+    private:
+        parity_union_find_t<IndexT> components_;
+        std::vector<IndexT> forest_;
+
+        bool with_certificate_;
+        bool is_bipartite_ = true;
+        size_t count_verts_ = 0;
+        IndexT conflict_v1_ = 0;
+        IndexT conflict_v2_ = 0;
+
+    private:
+        void add_vertex(size_t v) {
+            if (v + 1 >= MAX_INDEX) {
+                std::ostringstream oss;
+                oss << "Invalid input: graph does not fit into index type, "
+                    << "required slots: " << v + 1 << ", "
+                    << "max index: "      << MAX_INDEX;
+                throw error_t{oss.str()};
+            }
+
+            count_verts_ = std::max(count_verts_, v + 1);
+            if (v >= components_.size())
+                components_.resize(v + 1);
+        }
+
+        /* BFS in the forest from conflict_v2, its path to conflict_v1 closes the cycle */
+        std::vector<size_t> find_odd_cycle(size_t count_verts) const {
+            std::vector<IndexT> offsets(count_verts + 1, 0);
+            for (auto v : forest_)
+                offsets[v + 1]++;
+            std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+            std::vector<IndexT> neighbors(forest_.size());
+            std::vector<IndexT> curr_idx(offsets.begin(), offsets.end() - 1);
+            for (size_t i = 0; i < forest_.size(); i += 2) {
+                neighbors[curr_idx[forest_[i]]++]     = forest_[i + 1];
+                neighbors[curr_idx[forest_[i + 1]]++] = forest_[i];
+            }
+
+            IndexT end_parent = static_cast<IndexT>(count_verts + 1);
+            std::vector<IndexT> parents(count_verts, end_parent);
+            std::vector<IndexT> queue(1, conflict_v2_);
+            for (size_t head = 0; head < queue.size() && parents[conflict_v1_] == end_parent; ++head) {
+                IndexT u = queue[head];
+                for (IndexT i = offsets[u]; i < offsets[u + 1]; ++i) {
+                    IndexT next = neighbors[i];
+                    if (next != conflict_v2_ && parents[next] == end_parent) {
+                        parents[next] = u;
+                        queue.push_back(next);
+                    }
+                }
+            }
+
+            return get_odd_cycle(conflict_v1_, conflict_v2_, count_verts, parents);
+        }
+
+    public:
+        explicit stream_bipartite_t(bool with_certificate = false) : with_certificate_(with_certificate) {}
+
+        template <typename GraphT>
+        explicit stream_bipartite_t(const GraphT& graph, bool with_certificate = false)
+        : components_(graph.count_verts()), with_certificate_(with_certificate), count_verts_(graph.count_verts()) {
+            for (size_t v = 0; v < graph.count_verts() && is_bipartite_; ++v)
+                for (auto child : graph.get_range_children({graph, v}))
+                    if (child.index() >= v)
+                        add_edge(v, child.index());
+        }
+
+        /* returns false once the graph is known to be not bipartite, next edges are ignored */
+        bool add_edge(size_t v1, size_t v2) {
+            if (!is_bipartite_)
+                return false;
+
+            add_vertex(std::max(v1, v2));
+            auto status = components_.unite(static_cast<IndexT>(v1), static_cast<IndexT>(v2), true);
+            if (status == unite_status_t::joined && with_certificate_) {
+                forest_.push_back(static_cast<IndexT>(v1));
+                forest_.push_back(static_cast<IndexT>(v2));
+            } else if (status == unite_status_t::conflict) {
+                is_bipartite_ = false;
+                conflict_v1_ = static_cast<IndexT>(v1);
+                conflict_v2_ = static_cast<IndexT>(v2);
+            }
+            return is_bipartite_;
+        }
+
+        bool is_bipartite() const noexcept { return is_bipartite_; }
+
+        /* colors are the same as get_bipartite gives for graph_t of these edges:
+           minimal vertex of every component is 0, count of vertices is padded as in graph_t */
+        get_bipartite_result_t result() {
+            size_t count_verts = count_verts_ + count_verts_ % 2;
+            components_.resize(std::max(components_.size(), count_verts));
+
+            if (!is_bipartite_) {
+                if (!with_certificate_)
+                    return {false, {}, {}};
+                return {false, {}, find_odd_cycle(count_verts)};
+            }
+
+            std::vector<int> colors(count_verts, -1);
+            for (size_t v = 0; v < count_verts; ++v) {
+                auto [root, parity] = components_.find(static_cast<IndexT>(v));
+                if (colors[root] == -1)
+                    colors[root] = parity;
+                colors[v] = parity ^ colors[root];
+            }
+            return {true, std::move(colors), {}};
+        }
+
+        size_t count_verts() const noexcept { return count_verts_; }
+    };
+
+    /* input is std::string_view or std::istream&, parsing stops on the first conflict */
+    template <typename EdgeT, typename IndexT = size_t, typename InputT>
+    inline get_bipartite_result_t get_stream_bipartite(InputT&& input, bool with_certificate = false) {
+        GRAPH_STATS_TIMER("stream_bipartite");
+        stream_bipartite_t<IndexT> bipartite{with_certificate};
+        for_each_edge<EdgeT>(std::forward<InputT>(input), [&](const auto& edge) {
+            return bipartite.add_edge(std::get<0>(edge), std::get<1>(edge));
+        });
+        return bipartite.result();
+    }
+}
\ No newline at end of file
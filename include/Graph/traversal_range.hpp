@@ -0,0 +1,144 @@
+#pragma once
+
+#include "Graph/traversal_workspace.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <optional>
+#include <ranges>
+#include <tuple>
+
+namespace graph {
+    template <typename IndexT>
+    struct traversal_step_t final {
+        IndexT vertex;
+        IndexT depth;
+        IndexT parent;
+    };
+
+    enum class traversal_order_t { bfs, dfs };
+
+    /* Lazy traversal from start: every step of iteration takes one vertex from the
+       queue (stack for dfs) and discovers its children, so breaking out of the loop
+       stops the traversal. Parent of start is start itself. Input range: begin() once,
+       children of the graph must not change while it is iterated. */
+    template <typename GraphT, traversal_order_t Order>
+    class traversal_range_t final : public std::ranges::view_interface<traversal_range_t<GraphT, Order>> {
+        using index_t     = typename GraphT::index_t;
+        using step_t      = traversal_step_t<index_t>;
+        using workspace_t = traversal_workspace_t<index_t>;
+
+    private:
+        const GraphT* graph_;
+        index_t start_;
+
+        std::optional<details::workspace_lease_t<index_t>> lease_;
+        workspace_t* workspace_;
+
+        size_t head_      = 0;
+        size_t level_end_ = 1;
+        size_t max_queue_ = 0;
+        step_t current_{};
+        bool is_done_     = false;
+
+    private:
+        void discover(index_t vertex, index_t parent, index_t depth) {
+            workspace_->parents()[vertex] = parent;
+            if constexpr (Order == traversal_order_t::bfs)
+                workspace_->order().push_back(vertex);
+            else
+                workspace_->stack().emplace_back(vertex, depth);
+        }
+
+        bool next() {
+            index_t vertex, depth;
+            if constexpr (Order == traversal_order_t::bfs) {
+                auto& queue = workspace_->order();
+                if (head_ == queue.size())
+                    return false;
+
+                if (head_ == level_end_) {
+                    current_.depth++;
+                    level_end_ = queue.size();
+                }
+                max_queue_ = std::max(max_queue_, queue.size() - head_);
+                vertex = queue[head_++];
+                depth  = current_.depth;
+            } else {
+                auto& stack = workspace_->stack();
+                if (stack.empty())
+                    return false;
+                max_queue_ = std::max(max_queue_, stack.size());
+
+                std::tie(vertex, depth) = stack.back();
+                stack.pop_back();
+            }
+
+            for (auto child : graph_->get_range_children({*graph_, vertex})) {
+                index_t next = child.index();
+                if (workspace_->visit(next))
+                    discover(next, vertex, depth + 1);
+            }
+
+            current_ = {vertex, depth, workspace_->parents()[vertex]};
+            return true;
+        }
+
+    public:
+        class iterator_t final {
+            traversal_range_t* range_ = nullptr;
+
+        public:
+            using iterator_concept = std::input_iterator_tag;
+            using value_type       = step_t;
+            using difference_type  = std::ptrdiff_t;
+
+            iterator_t() = default;
+            explicit iterator_t(traversal_range_t& range) : range_(&range) {}
+
+            const step_t& operator*() const noexcept { return range_->current_; }
+            const step_t* operator->() const noexcept { return &range_->current_; }
+
+            iterator_t& operator++() {
+                range_->is_done_ = !range_->next();
+                return *this;
+            }
+            void operator++(int) { ++*this; }
+
+            bool operator==(std::default_sentinel_t) const noexcept { return range_->is_done_; }
+        };
+
+    public:
+        traversal_range_t(const GraphT& graph, typename GraphT::const_iterator_t start)
+        : graph_(&graph), start_(start.index()), lease_(std::in_place), workspace_(&lease_->get()) {}
+
+        traversal_range_t(const GraphT& graph, typename GraphT::const_iterator_t start, workspace_t& workspace)
+        : graph_(&graph), start_(start.index()), workspace_(&workspace) {}
+
+        iterator_t begin() {
+            workspace_->start(graph_->count_verts());
+            workspace_->visit(start_);
+            discover(start_, start_, 0);
+            is_done_ = !next();
+            return iterator_t{*this};
+        }
+
+        std::default_sentinel_t end() const noexcept { return {}; }
+
+        /* most vertexes discovered and not yet taken at once */
+        size_t queue_high_water() const noexcept { return max_queue_; }
+    };
+
+    template <typename GraphT, typename... WorkspaceT>
+    inline traversal_range_t<GraphT, traversal_order_t::bfs>
+    bfs_range(const GraphT& graph, typename GraphT::const_iterator_t start, WorkspaceT&... workspace) {
+        return {graph, start, workspace...};
+    }
+
+    template <typename GraphT, typename... WorkspaceT>
+    inline traversal_range_t<GraphT, traversal_order_t::dfs>
+    dfs_range(const GraphT& graph, typename GraphT::const_iterator_t start, WorkspaceT&... workspace) {
+        return {graph, start, workspace...};
+    }
+}
\ No newline at end of file
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <utility>
+#include <vector>
+
+namespace graph {
+    /* Buffers of traversals kept between calls. Visited marks are epoch stamps,
+       so a new traversal does not clear O(V) flags, only bumps the epoch.
+       Buffers come from resource, e.g. the arena of the graph traversed. */
+    template <typename IndexT>
+    class traversal_workspace_t final {
+        std::pmr::vector<uint32_t> stamps_;
+        uint32_t epoch_ = 0;
+
+        /* marks of a walk over results of the traversal, e.g. odd cycle over parents() */
+        std::pmr::vector<uint32_t> marks_;
+        uint32_t mark_epoch_ = 0;
+
+        std::pmr::vector<IndexT> order_;
+        std::pmr::vector<std::pair<IndexT, IndexT>> stack_;
+        std::pmr::vector<IndexT> parents_;
+
+        static void next_epoch(std::pmr::vector<uint32_t>& stamps, uint32_t& epoch) {
+            if (++epoch == 0) {
+                std::fill(stamps.begin(), stamps.end(), 0);
+                epoch = 1;
+            }
+        }
+
+    public:
+        explicit traversal_workspace_t(std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : stamps_(resource), marks_(resource), order_(resource), stack_(resource), parents_(resource) {}
+
+        /* forgets visited marks, buffers grow to count_verts once */
+        void start(size_t count_verts) {
+            if (stamps_.size() < count_verts) {
+                stamps_ .resize(count_verts, 0);
+                parents_.resize(count_verts);
+            }
+
+            next_epoch(stamps_, epoch_);
+            order_.clear();
+            stack_.clear();
+        }
+
+        /* forgets walk marks only, order(), stack() and parents() of the traversal are kept */
+        void start_marks(size_t count_verts) {
+            if (marks_.size() < count_verts)
+                marks_.resize(count_verts, 0);
+            next_epoch(marks_, mark_epoch_);
+        }
+
+        bool is_marked(size_t vertex) const noexcept { return marks_[vertex] == mark_epoch_; }
+        void mark(size_t vertex) noexcept { marks_[vertex] = mark_epoch_; }
+
+        bool is_visited(size_t vertex) const noexcept { return stamps_[vertex] == epoch_; }
+
+        /* returns true if vertex was not visited before */
+        bool visit(size_t vertex) noexcept {
+            if (stamps_[vertex] == epoch_)
+                return false;
+            stamps_[vertex] = epoch_;
+            return true;
+        }
+
+        std::pmr::vector<IndexT>& order()   noexcept { return order_; }
+        std::pmr::vector<std::pair<IndexT, IndexT>>& stack() noexcept { return stack_; }
+        std::pmr::vector<IndexT>& parents() noexcept { return parents_; }
+    };
+
+    namespace details {
+        /* Traversals without explicit workspace share one of the calling thread,
+           so its buffers are kept until the thread exits. While the shared one
+           is leased, e.g. by a traversal started from a callback, a fresh one is used.
+           Both use new/delete, the default resource may be an arena freed earlier. */
+        template <typename IndexT>
+        class workspace_lease_t final {
+            static inline thread_local traversal_workspace_t<IndexT> cached_{std::pmr::new_delete_resource()};
+            static inline thread_local bool is_busy_ = false;
+
+            std::unique_ptr<traversal_workspace_t<IndexT>> own_;
+            traversal_workspace_t<IndexT>* workspace_ = nullptr;
+
+            void release() noexcept {
+                if (workspace_ == &cached_)
+                    is_busy_ = false;
+                workspace_ = nullptr;
+            }
+
+        public:
+            workspace_lease_t() {
+                if (is_busy_) {
+                    own_ = std::make_unique<traversal_workspace_t<IndexT>>(std::pmr::new_delete_resource());
+                    workspace_ = own_.get();
+                } else {
+                    is_busy_ = true;
+                    workspace_ = &cached_;
+                }
+            }
+
+            workspace_lease_t(workspace_lease_t&& other) noexcept
+            : own_(std::move(other.own_)), workspace_(std::exchange(other.workspace_, nullptr)) {}
+
+            workspace_lease_t& operator=(workspace_lease_t&& other) noexcept {
+                if (this != &other) {
+                    release();
+                    own_ = std::move(other.own_);
+                    workspace_ = std::exchange(other.workspace_, nullptr);
+                }
+                return *this;
+            }
+
+            ~workspace_lease_t() { release(); }
+
+            traversal_workspace_t<IndexT>& get() const noexcept { return *workspace_; }
+        };
+
+        template <typename IndexT, typename Func>
+        inline decltype(auto) with_workspace(Func&& func) {
+            workspace_lease_t<IndexT> lease;
+            return func(lease.get());
+        }
+    }
+}
\ No newline at end of file
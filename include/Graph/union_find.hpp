@@ -0,0 +1,116 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace graph {
+    /* Lock-free disjoint set union: roots are linked by index (larger under smaller),
+       so the root of every set is its minimal element. find() uses path halving. */
+    template <typename IndexT>
+    class concurrent_union_find_t final {
+        std::vector<std::atomic<IndexT>> parents_;
+
+    public:
+        explicit concurrent_union_find_t(size_t size) : parents_(size) {
+            for (size_t i = 0; i < size; ++i)
+                parents_[i].store(static_cast<IndexT>(i), std::memory_order_relaxed);
+        }
+
+        IndexT find(IndexT v) noexcept {
+            while (true) {
+                IndexT parent = parents_[v].load(std::memory_order_relaxed);
+                if (parent == v)
+                    return v;
+
+                IndexT grandparent = parents_[parent].load(std::memory_order_relaxed);
+                if (parent != grandparent)
+                    parents_[v].compare_exchange_weak(parent, grandparent, std::memory_order_relaxed);
+                v = grandparent;
+            }
+        }
+
+        /* returns true if v1 and v2 were in different sets */
+        bool unite(IndexT v1, IndexT v2) noexcept {
+            while (true) {
+                v1 = find(v1);
+                v2 = find(v2);
+                if (v1 == v2)
+                    return false;
+
+                if (v1 < v2)
+                    std::swap(v1, v2);
+                IndexT expected = v1;
+                if (parents_[v1].compare_exchange_strong(expected, v2, std::memory_order_relaxed))
+                    return true;
+            }
+        }
+
+        size_t size() const noexcept { return parents_.size(); }
+    };
+
+    /* Disjoint set union which also keeps parity of every element relative to
+       its root, for 2-coloring constraints. Union by rank, path compression. */
+    template <typename IndexT>
+    class parity_union_find_t final {
+        std::vector<IndexT>  parents_;
+        std::vector<uint8_t> parities_;
+        std::vector<uint8_t> ranks_;
+
+    public:
+        enum class unite_status_t { joined, consistent, conflict };
+
+    public:
+        parity_union_find_t(size_t size = 0) { resize(size); }
+
+        /* new elements are singletons */
+        void resize(size_t size) {
+            size_t old_size = parents_.size();
+            parents_ .resize(size);
+            parities_.resize(size, 0);
+            ranks_   .resize(size, 0);
+            for (size_t i = old_size; i < size; ++i)
+                parents_[i] = static_cast<IndexT>(i);
+        }
+
+        /* returns root and parity of v relative to it */
+        std::pair<IndexT, bool> find(IndexT v) noexcept {
+            IndexT root = v;
+            bool parity = false;
+            while (parents_[root] != root) {
+                parity ^= parities_[root];
+                root = parents_[root];
+            }
+
+            for (bool curr_parity = parity; v != root && parents_[v] != root;) {
+                IndexT next = parents_[v];
+                bool next_parity = curr_parity ^ parities_[v];
+                parents_ [v] = root;
+                parities_[v] = curr_parity;
+                v = next;
+                curr_parity = next_parity;
+            }
+            return {root, parity};
+        }
+
+        /* adds constraint parity(v1) ^ parity(v2) == parity */
+        unite_status_t unite(IndexT v1, IndexT v2, bool parity) noexcept {
+            auto [root1, parity1] = find(v1);
+            auto [root2, parity2] = find(v2);
+            if (root1 == root2)
+                return ((parity1 ^ parity2) == parity) ? unite_status_t::consistent : unite_status_t::conflict;
+
+            if (ranks_[root1] < ranks_[root2])
+                std::swap(root1, root2);
+            else if (ranks_[root1] == ranks_[root2])
+                ranks_[root1]++;
+
+            parents_ [root2] = root1;
+            parities_[root2] = parity1 ^ parity2 ^ parity;
+            return unite_status_t::joined;
+        }
+
+        size_t size() const noexcept { return parents_.size(); }
+    };
+}
\ No newline at end of file
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "Graph/common.hpp"
+
+#include <cerrno>
+#include <charconv>
+#include <concepts>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include <unistd.h>
+
+namespace graph {
+    /* Output into a file descriptor through one buffer, numbers are formatted
+       by to_chars in place, every full buffer goes out with one write().
+       Nothing is flushed implicitly except in destructor, so mixing it with
+       std::cout on the same descriptor needs std::cout flushed first. */
+    class buffered_writer_t final {
+        static constexpr size_t BUFFER_SIZE = 1 << 16;
+        static constexpr size_t MAX_NUMBER_SIZE = 24;
+
+        int fd_;
+        std::unique_ptr<char[]> buffer_ = std::make_unique<char[]>(BUFFER_SIZE);
+        size_t size_ = 0;
+
+        void write_all(const char* data, size_t size) {
+            while (size > 0) {
+                ssize_t written = ::write(fd_, data, size);
+                if (written < 0) {
+                    if (errno == EINTR)
+                        continue;
+                    throw error_t{std::string{"Can not write output: "} + std::strerror(errno)};
+                }
+                data += written;
+                size -= static_cast<size_t>(written);
+            }
+        }
+
+    public:
+        explicit buffered_writer_t(int fd) : fd_(fd) {}
+
+        buffered_writer_t(const buffered_writer_t&) = delete;
+        buffered_writer_t& operator=(const buffered_writer_t&) = delete;
+
+        ~buffered_writer_t() {
+            try {
+                flush();
+            } catch (...) {}
+        }
+
+        void write(std::string_view data) {
+            if (data.size() > BUFFER_SIZE - size_) {
+                flush();
+                if (data.size() >= BUFFER_SIZE)
+                    return write_all(data.data(), data.size());
+            }
+            std::memcpy(buffer_.get() + size_, data.data(), data.size());
+            size_ += data.size();
+        }
+
+        void put(char c) {
+            if (size_ == BUFFER_SIZE)
+                flush();
+            buffer_[size_++] = c;
+        }
+
+        template <std::integral T>
+        void write_number(T value) {
+            if (BUFFER_SIZE - size_ < MAX_NUMBER_SIZE)
+                flush();
+            auto [end, error] = std::to_chars(buffer_.get() + size_, buffer_.get() + BUFFER_SIZE, value);
+            size_ = static_cast<size_t>(end - buffer_.get());
+        }
+
+        void flush() {
+            size_t size = std::exchange(size_, 0);
+            write_all(buffer_.get(), size);
+        }
+    };
+}
\ No newline at end of file
@@ -1,4 +1,81 @@
 #include "Graph/graph.hpp"
+#include "Graph/external_graph.hpp"
+#include "Graph/matching.hpp"
+#include "Graph/parallel_bipartite.hpp"
+#include "Graph/reorder.hpp"
+#include "Graph/shortest_paths.hpp"
+#include "Graph/stream_bipartite.hpp"
+#include "Graph/writer.hpp"
+
+#include <charconv>
+#include <cstddef>
+#include <cstdlib>
+#include <fstream>
+#include <new>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unistd.h>
+
+/* every replaceable form, so the counts are complete and each delete matches its new */
+#ifdef GRAPH_ALLOC_STATS
+namespace {
+    void* allocate(size_t size, size_t alignment) {
+        GRAPH_STATS_ADD(allocations, 1);
+        GRAPH_STATS_ADD(allocated_bytes, size);
+        size = size ? size : 1;
+        while (true) {
+            void* ptr = (alignment <= alignof(std::max_align_t))
+                      ? std::malloc(size)
+                      : std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+            if (ptr)
+                return ptr;
+
+            std::new_handler handler = std::get_new_handler();
+            if (!handler)
+                throw std::bad_alloc{};
+            handler();
+        }
+    }
+
+    void* allocate_nothrow(size_t size, size_t alignment) noexcept {
+        try {
+            return allocate(size, alignment);
+        } catch (...) {
+            return nullptr;
+        }
+    }
+
+    constexpr size_t DEFAULT_ALIGNMENT = alignof(std::max_align_t);
+}
+
+void* operator new  (size_t size) { return allocate(size, DEFAULT_ALIGNMENT); }
+void* operator new[](size_t size) { return allocate(size, DEFAULT_ALIGNMENT); }
+void* operator new  (size_t size, std::align_val_t alignment) { return allocate(size, static_cast<size_t>(alignment)); }
+void* operator new[](size_t size, std::align_val_t alignment) { return allocate(size, static_cast<size_t>(alignment)); }
+
+void* operator new  (size_t size, const std::nothrow_t&) noexcept { return allocate_nothrow(size, DEFAULT_ALIGNMENT); }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept { return allocate_nothrow(size, DEFAULT_ALIGNMENT); }
+void* operator new  (size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return allocate_nothrow(size, static_cast<size_t>(alignment));
+}
+void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return allocate_nothrow(size, static_cast<size_t>(alignment));
+}
+
+void operator delete  (void* ptr) noexcept { std::free(ptr); }
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+void operator delete  (void* ptr, size_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, size_t) noexcept { std::free(ptr); }
+void operator delete  (void* ptr, std::align_val_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, std::align_val_t) noexcept { std::free(ptr); }
+void operator delete  (void* ptr, size_t, std::align_val_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, size_t, std::align_val_t) noexcept { std::free(ptr); }
+void operator delete  (void* ptr, const std::nothrow_t&) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { std::free(ptr); }
+void operator delete  (void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { std::free(ptr); }
+#endif
 
 #if defined(WITH_DFS) || defined(WITH_BFS)
 void print_int(int i, std::ostream& os) {
@@ -6,33 +83,254 @@ void print_int(int i, std::ostream& os) {
 }
 #endif
 
-int main() try {
-    using Graph = graph::graph_t<std::monostate, int>;
-    Graph graph;
-    std::cin >> graph;
+struct options_t final {
+    std::string to_snapshot;
+    std::string snapshot;
+    std::string to_external;
+    std::string external;
+    unsigned count_threads = 0;
+    std::optional<graph::reorder_t> reorder;
+    std::optional<size_t> shortest_paths_from;
+    bool stream = false;
+    bool stats  = false;
+    bool packed = false;
+    bool matching = false;
+};
+
+bool parse_count_threads(std::string_view arg, unsigned& count_threads) {
+    auto [end, error] = std::from_chars(arg.data(), arg.data() + arg.size(), count_threads);
+    return (error == std::errc{} && end == arg.data() + arg.size() && count_threads > 0);
+}
 
+bool parse_vertex(std::string_view arg, std::optional<size_t>& vertex) {
+    size_t value = 0;
+    auto [end, error] = std::from_chars(arg.data(), arg.data() + arg.size(), value);
+    if (error != std::errc{} || end != arg.data() + arg.size() || value == 0)
+        return false;
+    vertex = value - 1;
+    return true;
+}
+
+/* GRAPH_STATS=1 in the environment works as --stats */
+options_t parse_options(int argc, char* argv[]) {
+    options_t options;
+    const char* stats_env = std::getenv("GRAPH_STATS");
+    options.stats = (stats_env && *stats_env && std::string_view{stats_env} != "0");
+
+    for (int i = 1; i < argc; ++i) {
+        std::string_view arg = argv[i];
+        if ((arg == "--to-snapshot" || arg == "--snapshot") && i + 1 < argc)
+            (arg == "--snapshot" ? options.snapshot : options.to_snapshot) = argv[++i];
+        else if ((arg == "--to-external" || arg == "--external") && i + 1 < argc)
+            (arg == "--external" ? options.external : options.to_external) = argv[++i];
+        else if (arg == "--reorder" && i + 1 < argc)
+            options.reorder = graph::parse_reorder(argv[++i]);
+        else if (arg == "--stream")
+            options.stream = true;
+        else if (arg == "--stats")
+            options.stats = true;
+        else if (arg == "--packed")
+            options.packed = true;
+        else if (arg == "--matching")
+            options.matching = true;
+        else if (arg == "--threads" && i + 1 < argc && parse_count_threads(argv[++i], options.count_threads))
+            continue;
+        else if (arg == "--shortest-paths" && i + 1 < argc && parse_vertex(argv[++i], options.shortest_paths_from))
+            continue;
+        else
+            throw graph::error_t{"Invalid argument: " + std::string{arg} +
+                                 "\nusage: graph [--to-snapshot <file> | --snapshot <file> | --to-external <file> | --external <file> | --stream]"
+                                 " [--threads <n>] [--reorder <bfs|rcm|degree>] [--shortest-paths <v> | --matching] [--stats] [--packed]"};
+    }
+    return options;
+}
+
+template <typename GraphT>
+void read_graph(GraphT& graph) {
+    if (graph::mapped_file_t::is_mappable(STDIN_FILENO)) {
+        graph::mapped_file_t input{STDIN_FILENO};
+        graph.read(input.view());
+    } else {
+        std::cin >> graph;
+    }
+}
+
+/* "GRAPHCOL", count of vertices as 8 bytes little-endian, then bit v % 8 of byte v / 8 is 1 for red */
+void write_packed_colors(graph::buffered_writer_t& writer, const std::vector<int>& colors) {
+    writer.write("GRAPHCOL");
+    uint64_t count_verts = colors.size();
+    for (int byte = 0; byte < 8; ++byte)
+        writer.put(static_cast<char>(count_verts >> (8 * byte)));
+
+    for (size_t v = 0; v < colors.size(); v += 8) {
+        unsigned char bits = 0;
+        for (size_t bit = 0; bit < 8 && v + bit < colors.size(); ++bit)
+            bits |= (colors[v + bit] ? 1 : 0) << bit;
+        writer.put(static_cast<char>(bits));
+    }
+}
+
+void print_bipartite(const graph::get_bipartite_result_t& result, bool packed = false) {
+    GRAPH_STATS_TIMER("print");
+    auto&& [is_bipartite, colors, cycle] = result;
+
+    std::cout.flush();
+    graph::buffered_writer_t writer{STDOUT_FILENO};
+    if (!is_bipartite) {
+        writer.write("graph is not bipartite, odd cycle:\n");
+        for (auto v : cycle) {
+            writer.write_number(v + 1);
+            writer.put(' ');
+        }
+        writer.put('\n');
+    } else if (packed) {
+        write_packed_colors(writer, colors);
+    } else {
+        for (size_t v = 0; v < colors.size(); ++v) {
+            writer.write_number(v + 1);
+            writer.write(colors[v] ? " r " : " b ");
+        }
+        writer.put('\n');
+    }
+}
+
+/* "v distance" for every vertex in original ids, "inf" if not reachable */
+template <typename GraphT>
+void print_shortest_paths(const GraphT& graph, size_t start, unsigned count_threads) {
+    typename GraphT::const_iterator_t iter{graph, graph::internal_id(graph, start)};
+    auto result = count_threads ? get_parallel_shortest_paths(graph, iter, 0, count_threads)
+                                : get_shortest_paths(graph, iter);
+
+    GRAPH_STATS_TIMER("print");
+    std::cout.flush();
+    graph::buffered_writer_t writer{STDOUT_FILENO};
+    for (size_t v = 0; v < graph.count_verts(); ++v) {
+        size_t internal = graph::internal_id(graph, v);
+        writer.write_number(v + 1);
+        writer.put(' ');
+        if (result.is_reachable(internal))
+            writer.write_number(result.distances[internal]);
+        else
+            writer.write("inf");
+        writer.put('\n');
+    }
+}
+
+/* size of maximum matching, then its pairs as "left right", left has color "b" */
+template <typename GraphT>
+void print_matching(const GraphT& graph, const graph::get_bipartite_result_t& bipartite, unsigned count_threads) {
+    auto result = graph::get_maximum_matching(graph, bipartite, std::max(count_threads, 1U));
+
+    GRAPH_STATS_TIMER("print");
+    std::cout.flush();
+    graph::buffered_writer_t writer{STDOUT_FILENO};
+    writer.write("maximum matching: ");
+    writer.write_number(result.size);
+    writer.put('\n');
+    for (size_t v = 0; v < result.mates.size(); ++v) {
+        if (!result.is_matched(v) || bipartite.colors[v])
+            continue;
+        writer.write_number(v + 1);
+        writer.put(' ');
+        writer.write_number(result.mates[v] + 1);
+        writer.put('\n');
+    }
+}
+
+graph::get_bipartite_result_t read_stream_bipartite() {
+    if (graph::mapped_file_t::is_mappable(STDIN_FILENO)) {
+        graph::mapped_file_t input{STDIN_FILENO};
+        return graph::get_stream_bipartite<int>(input.view(), true);
+    }
+    return graph::get_stream_bipartite<int>(std::cin, true);
+}
+
+template <typename GraphT>
+void process_graph(const GraphT& graph, const options_t& options) {
 #if defined(WITH_DFS) || defined(WITH_BFS)
-    Graph::const_iterator_t iter{graph, 0};
+    typename GraphT::const_iterator_t iter{graph, graph::internal_id(graph, 0)};
     #ifdef WITH_BFS
-        do_bfs(graph, iter, print_int, std::cout);
+        do_bfs(graph, iter, [&](size_t v) { print_int(graph::original_id(graph, v), std::cout); });
     #else
-        do_dfs(graph, iter, print_int, std::cout);
+        do_dfs(graph, iter, [&](size_t v) { print_int(graph::original_id(graph, v), std::cout); });
     #endif
 #endif
 
-    auto&& [is_bipartite, colors, cycle] = get_bipartite(graph);
+    if (options.shortest_paths_from) {
+        if (*options.shortest_paths_from >= graph.count_verts())
+            throw graph::error_t{"Invalid vertex index: " + std::to_string(*options.shortest_paths_from + 1)};
+        print_shortest_paths(graph, *options.shortest_paths_from, options.count_threads);
+        return;
+    }
 
-    if (!is_bipartite) {
-        std::cout << "graph is not bipartite, odd cycle:\n";
-        for (int i = 0, end = cycle.size(); i < end; ++i)
-            std::cout << cycle[i] + 1 << " ";
-        std::cout << '\n';
-    } else {
-        for (int i = 0, end = colors.size(); i < end; ++i)
-            std::cout << i + 1 << " " << (colors[i] ? 'r' : 'b') << " ";
-        std::cout << '\n';
+    auto bipartite = options.count_threads ? get_parallel_bipartite(graph, options.count_threads)
+                                           : get_bipartite(graph);
+    if (options.matching && bipartite.is_bipartite)
+        print_matching(graph, bipartite, options.count_threads);
+    else
+        print_bipartite(bipartite, options.packed);
+}
+
+void run(const options_t& options) {
+    using Graph    = graph::graph_t<std::monostate, int>;
+    using Snapshot = graph::graph_snapshot_t<std::monostate, int>;
+    using External = graph::external_graph_t<std::monostate, int>;
+
+    if (options.stream) {
+        print_bipartite(read_stream_bipartite(), options.packed);
+        return;
     }
 
+    if (!options.snapshot.empty()) {
+        Snapshot snapshot{options.snapshot};
+        process_graph(snapshot, options);
+        return;
+    }
+
+    /* both passes of the build read stdin, so it must be a file */
+    if (!options.to_external.empty()) {
+        if (!graph::mapped_file_t::is_mappable(STDIN_FILENO))
+            throw graph::error_t{"--to-external needs a regular file on stdin"};
+        graph::mapped_file_t input{STDIN_FILENO};
+        graph::write_external_graph<int>(input.view(), options.to_external);
+        return;
+    }
+
+    if (!options.external.empty()) {
+        [[maybe_unused]] graph::io_usage_t before = graph::get_io_usage();
+        External external{options.external};
+        process_graph(external, options);
+        GRAPH_STATS_ADD(bytes_read, (graph::get_io_usage() - before).read_bytes);
+        return;
+    }
+
+    Graph graph;
+    read_graph(graph);
+    if (options.reorder)
+        graph::reorder(graph, *options.reorder);
+
+    if (!options.to_snapshot.empty()) {
+        std::ofstream snapshot_file{options.to_snapshot, std::ios::binary};
+        if (!snapshot_file)
+            throw graph::error_t{"Can not open snapshot file: " + options.to_snapshot};
+        graph.write_snapshot(snapshot_file);
+        return;
+    }
+
+    process_graph(graph, options);
+}
+
+int main(int argc, char* argv[]) try {
+    options_t options = parse_options(argc, argv);
+    graph::stats::registry_t::instance().set_enabled(options.stats);
+    {
+        GRAPH_STATS_TIMER("total");
+        run(options);
+    }
+
+    if (options.stats)
+        graph::stats::registry_t::instance().write_json(std::cerr) << '\n';
+
 } catch (const graph::error_t& error) {
     std::cout << error.what() << '\n';
     return 1;
@@ -1,10 +1,32 @@
 #include "Graph/graph.hpp"
+#include "Graph/components.hpp"
+#include "Graph/csr_graph.hpp"
+#include "Graph/external_graph.hpp"
+#include "Graph/matching.hpp"
+#include "Graph/memory.hpp"
+#include "Graph/multi_source_bfs.hpp"
+#include "Graph/parallel_bfs.hpp"
+#include "Graph/parallel_bipartite.hpp"
+#include "Graph/reorder.hpp"
+#include "Graph/shortest_paths.hpp"
+#include "Graph/spanning_forest.hpp"
+#include "Graph/stats.hpp"
+#include "Graph/writer.hpp"
+#include "Graph/stream_bipartite.hpp"
 #include <gtest/gtest.h>
 #include <algorithm>
+#include <cstdlib>
 #include <filesystem>
 #include <fstream>
+#include <functional>
+#include <new>
+#include <queue>
+#include <random>
+#include <stdexcept>
 #include <vector>
 
+#include <unistd.h>
+
 template <typename T>
 void assert_vectors_eq(const std::vector<T>& expected, const std::vector<T>& actual) {
     ASSERT_EQ(expected.size(), actual.size());
@@ -13,10 +35,52 @@ void assert_vectors_eq(const std::vector<T>& expected, const std::vector<T>& act
         EXPECT_EQ(expected[i], actual[i]) << "at index " << i << '\n';
 }
 
+/* allocations of the calling thread, to check that reused buffers allocate nothing */
+static thread_local size_t count_allocations = 0;
+
+void* operator new(size_t size) {
+    ++count_allocations;
+    if (void* ptr = std::malloc(size ? size : 1))
+        return ptr;
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, size_t) noexcept { std::free(ptr); }
+
 void create_path(int v, std::vector<int>& path) {
     path.push_back(v);
 }
 
+template <typename GraphT>
+std::vector<size_t> get_bfs_levels(const GraphT& graph, size_t start) {
+    std::vector<size_t> levels(graph.count_verts(), std::numeric_limits<size_t>::max());
+    std::queue<size_t> q;
+    levels[start] = 0;
+    q.push(start);
+    while (!q.empty()) {
+        size_t v = q.front();
+        q.pop();
+        for (auto child : graph.get_range_children({graph, v})) {
+            if (levels[child.index()] == std::numeric_limits<size_t>::max()) {
+                levels[child.index()] = levels[v] + 1;
+                q.push(child.index());
+            }
+        }
+    }
+    return levels;
+}
+
+std::string generate_random_graph(size_t count_verts, size_t count_edges, unsigned seed) {
+    std::mt19937 gen{seed};
+    std::uniform_int_distribution<size_t> vertex(1, count_verts);
+
+    std::string input;
+    for (size_t i = 0; i < count_edges; ++i)
+        input += std::to_string(vertex(gen)) + " -- " + std::to_string(vertex(gen)) + ", 1\n";
+    return input;
+}
+
 std::vector<std::string> get_sorted_files(std::filesystem::path path) {
     std::vector<std::string> files;
 
@@ -27,6 +91,32 @@ std::vector<std::string> get_sorted_files(std::filesystem::path path) {
     return files;
 }
 
+/* unique file in the temp directory, so parallel runs do not share it;
+   removed on leaving the scope, also by a failed ASSERT */
+class temp_file_t final {
+    std::filesystem::path path_;
+
+public:
+    explicit temp_file_t(const std::string& name) {
+        std::string pattern = (std::filesystem::temp_directory_path() / (name + ".XXXXXX")).string();
+        int fd = mkstemp(pattern.data());
+        if (fd < 0)
+            throw std::runtime_error{"Can not create temporary file: " + pattern};
+        close(fd);
+        path_ = pattern;
+    }
+
+    temp_file_t(const temp_file_t&) = delete;
+    temp_file_t& operator=(const temp_file_t&) = delete;
+
+    ~temp_file_t() {
+        std::error_code error;
+        std::filesystem::remove(path_, error);
+    }
+
+    const std::filesystem::path& path() const noexcept { return path_; }
+};
+
 TEST(Graph_shuffle, cmp_ete_with_core) {
     std::string file{__FILE__};
     std::filesystem::path dir = file.substr(0, file.rfind('/'));
@@ -169,7 +259,1188 @@ TEST(Graph_bfs, test_simple_bfs) {
     graph::graph_t<>::const_iterator_t iter{graph, 1};
     do_bfs(graph, iter, create_path, ans);
 
-    assert_vectors_eq(ans, {1, 3, 0 ,2});
+    assert_vectors_eq(ans, {1, 0, 3, 2});
+}
+
+TEST(Graph_parser, test_read_errors) {
+    auto get_error = [](std::string input) -> std::string {
+        graph::graph_t<std::monostate, int> graph;
+        try {
+            graph.read(input);
+        } catch (const graph::error_t& error) {
+            return error.what();
+        }
+        return "";
+    };
+
+    EXPECT_EQ(get_error("1 -- 2, 3\n"), "");
+    EXPECT_EQ(get_error("1 -- x, 3\n"), "Invalid edge indexes");
+    EXPECT_EQ(get_error("1 -- 2"), "Invalid edge info");
+    EXPECT_EQ(get_error("1 - 2, 3"), "Invalid input: expected dashes between vertex indexes, read: -");
+    EXPECT_EQ(get_error("0 -- 2, 3"), "Invalid vertex index: <= 0");
+    EXPECT_EQ(get_error("1 -- 2; 3"), "Invalid input: expected comma, read: ;");
+    EXPECT_EQ(get_error("1 -- 2, w"), "Invalid edge info");
+    EXPECT_EQ(get_error("1 --\n2, 3"), "Invalid edge indexes");
+    EXPECT_EQ(get_error("1 -- 2,\n3"), "Invalid edge info");
+}
+
+TEST(Graph_parser, test_incomplete_chunk) {
+    using parser_t = graph::edge_parser_t<int>;
+
+    std::string input = "1 -- 2, 3\n4 --";
+    parser_t parser{input, false};
+    parser_t::edge_t edge;
+
+    EXPECT_EQ(parser.parse(edge), parser_t::status_t::edge);
+    EXPECT_EQ(edge, parser_t::edge_t(0, 1, 3));
+    EXPECT_EQ(parser.parse(edge), parser_t::status_t::incomplete);
+    EXPECT_EQ(parser.position(), input.find('4'));
+}
+
+TEST(Graph_parser, test_stream_eq_mapped) {
+    std::string file{__FILE__};
+    std::filesystem::path dir = file.substr(0, file.rfind('/'));
+    std::vector<std::string> tests_str = get_sorted_files(dir / "../end_to_end/tests_in/");
+
+    for (auto& test : tests_str) {
+        std::ifstream test_file(test);
+        graph::graph_t<std::monostate, int> graph_stream;
+        test_file >> graph_stream;
+
+        graph::mapped_file_t mapped{std::filesystem::path{test}};
+        graph::graph_t<std::monostate, int> graph_mapped;
+        graph_mapped.read(mapped.view());
+
+        auto result_stream = get_bipartite(graph_stream);
+        auto result_mapped = get_bipartite(graph_mapped);
+        EXPECT_EQ(result_stream.is_bipartite, result_mapped.is_bipartite) << "in test : " << test << '\n';
+        EXPECT_EQ(result_stream.colors,       result_mapped.colors)       << "in test : " << test << '\n';
+        EXPECT_EQ(result_stream.cycle,        result_mapped.cycle)        << "in test : " << test << '\n';
+    }
+}
+
+TEST(Graph_parser, test_parallel_eq_sequential) {
+    using parser_t = graph::edge_parser_t<int>;
+
+    std::string input;
+    for (int i = 0; i < 400000; ++i)
+        input += std::to_string(i % 1000 + 1) + " -- " + std::to_string(i % 777 + 1) + ", " + std::to_string(i) + '\n';
+
+    std::vector<parser_t::edge_t> sequential, parallel;
+    graph::for_each_edge<int>(input, [&](auto&& edge) { sequential.push_back(edge); });
+    graph::for_each_edge<int>(input, [&](auto&& edge) { parallel.push_back(edge); }, 4);
+    EXPECT_EQ(sequential, parallel);
+
+    graph::graph_t<std::monostate, int> assigned, read;
+    assigned.assign(sequential);
+    read.read(input, 0, 1);
+    ASSERT_EQ(read.count_edges(), assigned.count_edges());
+    for (size_t e = 0; e < read.count_edges(); ++e)
+        EXPECT_EQ(read.get_edge_verts(e), assigned.get_edge_verts(e));
+
+    auto get_error = [](const std::string& input, unsigned count_threads) -> std::string {
+        try {
+            graph::for_each_edge<int>(input, [](auto&&) {}, count_threads);
+        } catch (const graph::error_t& e) {
+            return e.what();
+        }
+        return "";
+    };
+
+    /* an edge split across lines is rejected whatever the size of input */
+    size_t middle = input.find('\n', input.size() / 2) + 1;
+    std::string split_edge = input.substr(0, middle) + "1 -- 2,\n3\n" + input.substr(middle);
+    ASSERT_GT(split_edge.size(), 1U << 20);
+    EXPECT_EQ(get_error(split_edge, 1), "Invalid edge info");
+    EXPECT_EQ(get_error(split_edge, 4), "Invalid edge info");
+    EXPECT_EQ(get_error("1 -- 2,\n3\n", 4), "Invalid edge info");
+
+    input += "1 -- 2, x\n";
+    EXPECT_EQ(get_error(input, 4), "Invalid edge info");
+}
+
+TEST(Graph_csr, test_csr_eq_linked) {
+    std::string file{__FILE__};
+    std::filesystem::path dir = file.substr(0, file.rfind('/'));
+    std::vector<std::string> tests_str = get_sorted_files(dir / "../end_to_end/tests_in/");
+
+    for (auto& test : tests_str) {
+        std::ifstream test_file(test);
+        graph::graph_t<std::monostate, int> graph;
+        test_file >> graph;
+        auto csr = graph::to_csr(graph);
+
+        auto result_linked = get_bipartite(graph);
+        auto result_csr    = get_bipartite(csr);
+        EXPECT_EQ(result_linked.is_bipartite, result_csr.is_bipartite) << "in test : " << test << '\n';
+        EXPECT_EQ(result_linked.colors,       result_csr.colors)       << "in test : " << test << '\n';
+        EXPECT_EQ(result_csr.cycle.size() % 2, result_linked.cycle.size() % 2);
+
+        std::vector<int> order_linked, order_csr;
+        do_bfs(graph, {graph, 0}, create_path, order_linked);
+        do_bfs(csr,   {csr,   0}, create_path, order_csr);
+        std::sort(order_linked.begin(), order_linked.end());
+        std::sort(order_csr.begin(),    order_csr.end());
+        EXPECT_EQ(order_linked, order_csr) << "in test : " << test << '\n';
+    }
+}
+
+TEST(Graph_csr, test_csr_children) {
+    graph::graph_t<std::monostate, int> graph{{1, 2, 10}, {1, 3, 20}, {2, 3, 30}};
+    auto csr = graph::to_csr(graph);
+
+    std::vector<std::pair<size_t, int>> children;
+    for (auto child : csr.get_range_children({csr, 2}))
+        children.emplace_back(child.index(), child.edge());
+
+    std::sort(children.begin(), children.end());
+    std::vector<std::pair<size_t, int>> expected{{0, 20}, {1, 30}};
+    EXPECT_EQ(children, expected);
+}
+
+TEST(Graph_index, test_uint32_eq_size_t) {
+    std::string file{__FILE__};
+    std::filesystem::path dir = file.substr(0, file.rfind('/'));
+    std::vector<std::string> tests_str = get_sorted_files(dir / "../end_to_end/tests_in/");
+
+    for (auto& test : tests_str) {
+        graph::mapped_file_t mapped{std::filesystem::path{test}};
+        graph::graph_t<std::monostate, int> graph;
+        graph::graph_t<std::monostate, int, uint32_t> graph32;
+        graph.read(mapped.view());
+        graph32.read(mapped.view());
+
+        auto result   = get_bipartite(graph);
+        auto result32 = get_bipartite(graph32);
+        EXPECT_EQ(result.is_bipartite, result32.is_bipartite) << "in test : " << test << '\n';
+        EXPECT_EQ(result.colors,       result32.colors)       << "in test : " << test << '\n';
+        EXPECT_EQ(result.cycle,        result32.cycle)        << "in test : " << test << '\n';
+    }
+}
+
+TEST(Graph_index, test_index_overflow) {
+    graph::graph_t<std::monostate, std::monostate, uint8_t> graph;
+    EXPECT_THROW(graph.read(std::string_view{"1 -- 300\n"}), graph::error_t);
+
+    std::string input;
+    for (int i = 1; i <= 120; ++i)
+        input += "1 -- " + std::to_string(i % 50 + 1) + "\n";
+    EXPECT_THROW(graph.read(input), graph::error_t);
+
+    graph.read(std::string_view{"1 -- 2\n2 -- 3\n"});
+    EXPECT_EQ(get_bipartite(graph).is_bipartite, true);
+}
+
+TEST(Graph_snapshot, test_snapshot_eq_graph) {
+    std::string file{__FILE__};
+    std::filesystem::path dir = file.substr(0, file.rfind('/'));
+    std::vector<std::string> tests_str = get_sorted_files(dir / "../end_to_end/tests_in/");
+    temp_file_t snapshot_file_guard{"graph_unit_test.snap"};
+    const std::filesystem::path& snapshot_path = snapshot_file_guard.path();
+
+    for (auto& test : tests_str) {
+        std::ifstream test_file(test);
+        graph::graph_t<std::monostate, int, uint32_t> graph;
+        test_file >> graph;
+        {
+            std::ofstream snapshot_file(snapshot_path, std::ios::binary);
+            graph.write_snapshot(snapshot_file);
+        }
+        graph::graph_snapshot_t<std::monostate, int, uint32_t> snapshot{snapshot_path};
+
+        ASSERT_EQ(graph.count_verts(), snapshot.count_verts());
+        ASSERT_EQ(graph.count_edges(), snapshot.count_edges());
+        for (size_t e = 0; e < graph.count_edges(); ++e) {
+            EXPECT_EQ(graph.get_edge_verts(e), snapshot.get_edge_verts(e));
+            EXPECT_EQ(graph.get_edge_info(e),  snapshot.get_edge_info(e));
+        }
+
+        auto result_graph    = get_bipartite(graph);
+        auto result_snapshot = get_bipartite(snapshot);
+        EXPECT_EQ(result_graph.is_bipartite, result_snapshot.is_bipartite) << "in test : " << test << '\n';
+        EXPECT_EQ(result_graph.colors,       result_snapshot.colors)       << "in test : " << test << '\n';
+        EXPECT_EQ(result_graph.cycle,        result_snapshot.cycle)        << "in test : " << test << '\n';
+    }
+
+    using wrong_index_snapshot_t = graph::graph_snapshot_t<std::monostate, int, size_t>;
+    EXPECT_THROW(wrong_index_snapshot_t{snapshot_path}, graph::error_t);
+
+    using snapshot_t = graph::graph_snapshot_t<std::monostate, int, uint32_t>;
+    graph::snapshot_header_t header;
+    {
+        std::ifstream snapshot_file(snapshot_path, std::ios::binary);
+        snapshot_file.read(reinterpret_cast<char*>(&header), sizeof(header));
+    }
+    auto overwrite = [&](uint64_t offset, uint32_t value) {
+        uint32_t old_value;
+        std::fstream snapshot_file(snapshot_path, std::ios::binary | std::ios::in | std::ios::out);
+        snapshot_file.seekg(offset);
+        snapshot_file.read(reinterpret_cast<char*>(&old_value), sizeof(old_value));
+        snapshot_file.seekp(offset);
+        snapshot_file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+        return old_value;
+    };
+    uint32_t old_end = overwrite(header.edges_offset, 1'000'000);
+    EXPECT_THROW(snapshot_t{snapshot_path}, graph::error_t);
+    EXPECT_NO_THROW((snapshot_t{snapshot_path, true}));
+    overwrite(header.edges_offset, old_end);
+    overwrite(header.next_offset, 1'000'000);
+    EXPECT_THROW(snapshot_t{snapshot_path}, graph::error_t);
+    overwrite(header.next_offset, 1);
+    EXPECT_THROW(snapshot_t{snapshot_path}, graph::error_t);
+
+    {
+        std::ofstream snapshot_file(snapshot_path, std::ios::binary | std::ios::in);
+        snapshot_file.write("BROKEN", 6);
+    }
+    EXPECT_THROW(snapshot_t{snapshot_path}, graph::error_t);
+}
+
+TEST(Graph_parallel_bfs, test_levels_eq_sequential) {
+    std::vector<std::string> inputs{generate_random_graph(2000, 20000, 1),
+                                    generate_random_graph(5000, 6000, 2),
+                                    generate_random_graph(300,  20000, 3)};
+
+    for (auto& input : inputs) {
+        graph::graph_t<std::monostate, int, uint32_t> graph;
+        graph.read(input);
+        std::vector<size_t> expected = get_bfs_levels(graph, 0);
+
+        for (unsigned count_threads : {1, 4}) {
+            auto result = graph::do_parallel_bfs(graph, {graph, 0}, count_threads);
+            for (size_t v = 0; v < graph.count_verts(); ++v) {
+                bool is_reachable = (expected[v] != std::numeric_limits<size_t>::max());
+                ASSERT_EQ(is_reachable, result.is_visited(v)) << "at vertex " << v << '\n';
+                if (!is_reachable)
+                    continue;
+
+                ASSERT_EQ(expected[v], result.levels[v]) << "at vertex " << v << '\n';
+                if (v == 0)
+                    continue;
+
+                size_t parent = result.parents[v];
+                ASSERT_EQ(result.levels[parent] + 1, result.levels[v]) << "at vertex " << v << '\n';
+                bool is_child = false;
+                for (auto child : graph.get_range_children({graph, parent}))
+                    is_child |= (child.index() == v);
+                ASSERT_TRUE(is_child) << "at vertex " << v << '\n';
+            }
+        }
+    }
+}
+
+/* graph_t whose children of one vertex can not be read, e.g. a lost page of a mapped file */
+class throwing_graph_t final {
+    using graph_type = graph::graph_t<std::monostate, int, uint32_t>;
+
+    const graph_type* graph_;
+    size_t bad_vertex_;
+
+public:
+    using index_t = uint32_t;
+
+    struct const_iterator_t final {
+        size_t index_;
+
+        const_iterator_t(const throwing_graph_t&, size_t index) : index_(index) {}
+        size_t index() const noexcept { return index_; }
+    };
+
+    throwing_graph_t(const graph_type& graph, size_t bad_vertex) : graph_(&graph), bad_vertex_(bad_vertex) {}
+
+    auto get_range_children(const_iterator_t iterator) const {
+        if (iterator.index() == bad_vertex_)
+            throw graph::error_t{"Invalid vertex: " + std::to_string(bad_vertex_)};
+        return graph_->get_range_children({*graph_, iterator.index()});
+    }
+
+    size_t count_verts() const noexcept { return graph_->count_verts(); }
+};
+
+TEST(Graph_parallel_bfs, test_throw_does_not_block) {
+    graph::graph_t<std::monostate, int, uint32_t> graph;
+    graph.read(generate_random_graph(5000, 20000, 1));
+    std::vector<size_t> levels = get_bfs_levels(graph, 0);
+    std::replace(levels.begin(), levels.end(), std::numeric_limits<size_t>::max(), size_t{0});
+
+    /* the root is read by top-down step, the deepest vertex by either step */
+    size_t deepest = std::ranges::max_element(levels) - levels.begin();
+    for (size_t bad_vertex : {size_t{0}, deepest}) {
+        throwing_graph_t throwing{graph, bad_vertex};
+        for (unsigned count_threads : {1, 4}) {
+            graph::parallel_bfs_t<throwing_graph_t> bfs{throwing, count_threads};
+            EXPECT_THROW(bfs.run(0), graph::error_t) << "bad vertex " << bad_vertex << '\n';
+        }
+    }
+}
+
+template <typename GraphT>
+bool is_odd_cycle(const GraphT& graph, const std::vector<size_t>& cycle) {
+    if (cycle.size() % 2 == 0)
+        return false;
+
+    /* self-loop is reported as three 0-based ids */
+    if (cycle.size() == 3 && cycle[0] == cycle[1] && cycle[1] == cycle[2]) {
+        bool is_child = false;
+        for (auto child : graph.get_range_children({graph, cycle[0]}))
+            is_child |= (child.index() == cycle[0]);
+        return is_child;
+    }
+
+    for (size_t i = 0; i < cycle.size(); ++i) {
+        size_t v = cycle[i] - 1, next = cycle[(i + 1) % cycle.size()] - 1;
+        bool is_child = false;
+        for (auto child : graph.get_range_children({graph, v}))
+            is_child |= (child.index() == next);
+        if (!is_child)
+            return false;
+    }
+    return true;
+}
+
+std::string generate_random_tree(size_t count_verts, unsigned seed) {
+    std::mt19937 gen{seed};
+
+    std::string input;
+    for (size_t v = 2; v <= count_verts; ++v)
+        input += std::to_string(std::uniform_int_distribution<size_t>(1, v - 1)(gen)) +
+                 " -- " + std::to_string(v) + ", 1\n";
+    return input;
+}
+
+TEST(Graph_parallel_bipartite, test_parallel_eq_sequential) {
+    std::string file{__FILE__};
+    std::filesystem::path dir = file.substr(0, file.rfind('/'));
+
+    std::vector<std::string> inputs;
+    for (auto& test : get_sorted_files(dir / "../end_to_end/tests_in/")) {
+        std::ifstream test_file(test);
+        inputs.emplace_back(std::istreambuf_iterator<char>{test_file}, std::istreambuf_iterator<char>{});
+    }
+    inputs.push_back(generate_random_tree(100000, 1));
+    inputs.push_back(generate_random_tree(100000, 2) + "1 -- 100000, 1\n");
+    inputs.push_back(generate_random_graph(100000, 50000, 3));
+
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        graph::graph_t<std::monostate, int, uint32_t> graph;
+        graph.read(inputs[i]);
+        auto expected = get_bipartite(graph);
+
+        for (unsigned count_threads : {2, 4}) {
+            auto result = graph::get_parallel_bipartite(graph, count_threads);
+            ASSERT_EQ(expected.is_bipartite, result.is_bipartite) << "in test : " << i + 1 << '\n';
+            if (expected.is_bipartite) {
+                EXPECT_EQ(expected.colors, result.colors) << "in test : " << i + 1 << '\n';
+            } else {
+                EXPECT_TRUE(is_odd_cycle(graph, result.cycle)) << "in test : " << i + 1 << '\n';
+            }
+        }
+    }
+}
+
+TEST(Graph_stream_bipartite, test_stream_eq_graph) {
+    std::string file{__FILE__};
+    std::filesystem::path dir = file.substr(0, file.rfind('/'));
+
+    std::vector<std::string> inputs;
+    for (auto& test : get_sorted_files(dir / "../end_to_end/tests_in/")) {
+        std::ifstream test_file(test);
+        inputs.emplace_back(std::istreambuf_iterator<char>{test_file}, std::istreambuf_iterator<char>{});
+    }
+    inputs.push_back(generate_random_tree(10001, 1));
+    inputs.push_back(generate_random_tree(10000, 2) + "1 -- 10000, 1\n");
+
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        graph::graph_t<std::monostate, int> graph;
+        graph.read(inputs[i]);
+        auto expected = get_bipartite(graph);
+
+        std::istringstream input_stream{inputs[i]};
+        auto result = graph::get_stream_bipartite<int, uint32_t>(input_stream, true);
+        ASSERT_EQ(expected.is_bipartite, result.is_bipartite) << "in test : " << i + 1 << '\n';
+        if (expected.is_bipartite) {
+            EXPECT_EQ(expected.colors, result.colors) << "in test : " << i + 1 << '\n';
+        } else {
+            EXPECT_TRUE(is_odd_cycle(graph, result.cycle)) << "in test : " << i + 1 << '\n';
+        }
+    }
+}
+
+TEST(Graph_stream_bipartite, test_stop_on_conflict) {
+    auto result = graph::get_stream_bipartite<int>(std::string_view{"1 -- 2, 1\n2 -- 2, 1\n3 -- x"}, true);
+    EXPECT_FALSE(result.is_bipartite);
+    EXPECT_EQ(result.cycle, std::vector<size_t>(3, 1));
+
+    EXPECT_THROW(graph::get_stream_bipartite<int>(std::string_view{"1 -- 2, 1\n3 -- x"}), graph::error_t);
+}
+
+template <typename GraphT>
+std::vector<std::vector<size_t>> get_sorted_children(const GraphT& graph) {
+    std::vector<std::vector<size_t>> children(graph.count_verts());
+    for (size_t v = 0; v < graph.count_verts(); ++v) {
+        for (auto child : graph.get_range_children({graph, v}))
+            children[v].push_back(child.index());
+        std::sort(children[v].begin(), children[v].end());
+    }
+    return children;
+}
+
+TEST(Graph_online, test_add_edge_eq_rebuild) {
+    std::string input = generate_random_graph(300, 200, 1) + generate_random_graph(1000, 400, 2);
+    std::vector<std::tuple<size_t, size_t, int>> edges;
+    graph::for_each_edge<int>(std::string_view{input}, [&](const auto& edge) { edges.push_back(edge); });
+
+    graph::graph_t<std::monostate, int, uint32_t> online;
+    online.read(input.substr(0, input.find("\n", input.size() / 4) + 1));
+    graph::stream_bipartite_t<uint32_t> bipartite{online};
+    size_t count_initial = online.count_edges();
+
+    std::string prefix;
+    for (size_t e = 0; e < edges.size(); ++e) {
+        auto [v1, v2, w] = edges[e];
+        prefix += std::to_string(v1 + 1) + " -- " + std::to_string(v2 + 1) + ", " + std::to_string(w) + "\n";
+        if (e >= count_initial) {
+            EXPECT_EQ(e, online.add_edge(v1, v2, w));
+            bipartite.add_edge(v1, v2);
+        }
+
+        if (e + 1 < count_initial || (e % 50 != 0 && e + 1 != edges.size()))
+            continue;
+
+        graph::graph_t<std::monostate, int, uint32_t> rebuilt;
+        rebuilt.read(prefix);
+        ASSERT_EQ(rebuilt.count_verts(), online.count_verts()) << "after edge " << e << '\n';
+        ASSERT_EQ(rebuilt.count_edges(), online.count_edges()) << "after edge " << e << '\n';
+        EXPECT_EQ(get_sorted_children(rebuilt), get_sorted_children(online)) << "after edge " << e << '\n';
+
+        auto expected = get_bipartite(rebuilt);
+        ASSERT_EQ(expected.is_bipartite, bipartite.is_bipartite()) << "after edge " << e << '\n';
+        if (expected.is_bipartite) {
+            EXPECT_EQ(expected.colors, bipartite.result().colors) << "after edge " << e << '\n';
+        }
+    }
+
+    std::stringstream snapshot;
+    online.write_snapshot(snapshot);
+    temp_file_t snapshot_file{"online.snap"};
+    std::ofstream{snapshot_file.path(), std::ios::binary} << snapshot.rdbuf();
+    graph::graph_snapshot_t<std::monostate, int, uint32_t> loaded{snapshot_file.path()};
+    EXPECT_EQ(get_sorted_children(online), get_sorted_children(loaded));
+}
+
+TEST(Graph_online, test_remove_edge_eq_rebuild) {
+    graph::graph_t<std::monostate, int, uint32_t> online;
+    online.read(generate_random_graph(500, 3000, 1));
+
+    std::vector<std::tuple<size_t, size_t, int>> edges;
+    for (size_t e = 0; e < online.count_edge_slots(); ++e) {
+        auto [v1, v2] = online.get_edge_verts(e);
+        edges.emplace_back(v1, v2, online.get_edge_info(e));
+    }
+
+    std::mt19937 gen{1};
+    std::vector<bool> is_live(edges.size(), true);
+    auto check_eq_rebuild = [&]() {
+        std::string live_input;
+        for (size_t e = 0; e < edges.size(); ++e) {
+            auto [v1, v2, w] = edges[e];
+            if (is_live[e])
+                live_input += std::to_string(v1 + 1) + " -- " + std::to_string(v2 + 1) + ", 1\n";
+        }
+
+        graph::graph_t<std::monostate, int, uint32_t> rebuilt;
+        rebuilt.read(live_input);
+        EXPECT_EQ(rebuilt.count_edges(), online.count_edges());
+        EXPECT_EQ(get_sorted_children(rebuilt), get_sorted_children(online));
+        EXPECT_EQ(get_sorted_children(rebuilt), get_sorted_children(graph::to_csr(online)));
+    };
+
+    for (size_t i = 0; i < 1000; ++i) {
+        size_t e = std::uniform_int_distribution<size_t>(0, edges.size() - 1)(gen);
+        if (!is_live[e]) {
+            EXPECT_THROW(online.remove_edge(e), graph::error_t);
+            continue;
+        }
+        online.remove_edge(e);
+        is_live[e] = false;
+    }
+    check_eq_rebuild();
+
+    size_t count_slots = online.count_edge_slots();
+    EXPECT_FALSE(online.compact(0.5));
+    size_t reused = online.add_edge(0, 1, 1);
+    EXPECT_TRUE(online.is_edge_removed(reused) == false && reused < count_slots);
+    edges[reused] = {0, 1, 1};
+    is_live[reused] = true;
+    check_eq_rebuild();
+
+    EXPECT_TRUE(online.compact(0.1));
+    EXPECT_EQ(online.count_edges(), online.count_edge_slots());
+    std::vector<std::tuple<size_t, size_t, int>> live_edges;
+    for (size_t e = 0; e < edges.size(); ++e)
+        if (is_live[e])
+            live_edges.push_back(edges[e]);
+    edges.swap(live_edges);
+    is_live.assign(edges.size(), true);
+    for (size_t e = 0; e < edges.size(); ++e) {
+        auto [v1, v2] = online.get_edge_verts(e);
+        EXPECT_EQ(std::make_pair(std::get<0>(edges[e]), std::get<1>(edges[e])), std::make_pair(v1, v2));
+    }
+    check_eq_rebuild();
+}
+
+TEST(Graph_workspace, test_reused_eq_fresh) {
+    graph::graph_t<std::monostate, int, uint32_t> graph1, graph2;
+    graph1.read(generate_random_graph(2000, 1500, 1));
+    graph2.read(generate_random_graph(500, 600, 2));
+
+    graph::traversal_workspace_t<uint32_t> workspace;
+    for (size_t start = 0; start < 500; start += 7) {
+        for (auto* graph : {&graph1, &graph2}) {
+            std::vector<int> order_fresh, order_reused;
+            do_dfs(*graph, {*graph, start}, create_path, order_fresh);
+            do_dfs(*graph, {*graph, start}, workspace, create_path, order_reused);
+            EXPECT_EQ(order_fresh, order_reused) << "dfs from " << start << '\n';
+
+            order_fresh.clear();
+            order_reused.clear();
+            do_bfs(*graph, {*graph, start}, create_path, order_fresh);
+            do_bfs(*graph, {*graph, start}, workspace, create_path, order_reused);
+            EXPECT_EQ(order_fresh, order_reused) << "bfs from " << start << '\n';
+
+            /* cycle walk over parents of a finished traversal keeps its marks and order */
+            if (start == 0) {
+                std::vector<uint32_t> parents{1, 2, 4};
+                auto order = workspace.order();
+                graph::get_odd_cycle(0, 1, 3, parents, workspace);
+                EXPECT_TRUE(workspace.is_visited(start));
+                EXPECT_TRUE(std::ranges::equal(order, workspace.order()));
+            }
+
+            auto expected = get_bipartite(*graph);
+            auto result   = get_bipartite(*graph, workspace);
+            EXPECT_EQ(expected.is_bipartite, result.is_bipartite);
+            EXPECT_EQ(expected.colors,       result.colors);
+            EXPECT_EQ(expected.cycle,        result.cycle);
+        }
+    }
+
+    std::vector<int> order_reused;
+    order_reused.reserve(graph1.count_verts());
+    for (int pass = 0; pass < 2; ++pass) {
+        size_t count_before = count_allocations;
+        order_reused.clear();
+        do_dfs(graph1, {graph1, 0}, workspace, create_path, order_reused);
+        order_reused.clear();
+        do_bfs(graph1, {graph1, 0}, workspace, create_path, order_reused);
+        if (pass > 0) {
+            EXPECT_EQ(count_before, count_allocations) << "reused workspace allocates\n";
+        }
+    }
+
+    std::vector<int> order, nested_order;
+    do_bfs(graph2, {graph2, 0}, [&](size_t v) {
+        order.push_back(v);
+        if (v == 0)
+            do_bfs(graph2, {graph2, 0}, create_path, nested_order);
+    });
+    EXPECT_EQ(order, nested_order);
+}
+
+TEST(Graph_traversal_range, test_steps_and_break) {
+    graph::graph_t<std::monostate, int, uint32_t> graph;
+    graph.read(generate_random_graph(3000, 4000, 1));
+    std::vector<size_t> levels = get_bfs_levels(graph, 0);
+
+    auto is_child = [&](size_t parent, size_t v) {
+        for (auto child : graph.get_range_children({graph, parent}))
+            if (child.index() == v)
+                return true;
+        return false;
+    };
+
+    size_t count_visited = 0;
+    for (auto [vertex, depth, parent] : graph::bfs_range(graph, {graph, 0})) {
+        EXPECT_EQ(levels[vertex], depth);
+        EXPECT_TRUE(vertex == 0 ? parent == 0 : is_child(parent, vertex));
+        count_visited++;
+    }
+    EXPECT_EQ(std::count_if(levels.begin(), levels.end(),
+                            [](size_t level) { return level != std::numeric_limits<size_t>::max(); }),
+              count_visited);
+
+    std::vector<int> dfs_order;
+    do_dfs(graph, {graph, 0}, create_path, dfs_order);
+    std::reverse(dfs_order.begin(), dfs_order.end());
+    size_t i = 0;
+    for (auto step : graph::dfs_range(graph, {graph, 0})) {
+        EXPECT_EQ(dfs_order[i++], step.vertex);
+        EXPECT_TRUE(step.vertex == 0 ? step.depth == 0 : is_child(step.parent, step.vertex));
+    }
+
+    graph::traversal_workspace_t<uint32_t> workspace;
+    size_t found = 0;
+    for (auto step : graph::bfs_range(graph, {graph, 0}, workspace)) {
+        if (step.depth == 2) {
+            found = step.vertex;
+            break;
+        }
+    }
+    EXPECT_EQ(levels[found], 2);
+    size_t count_discovered = 0;
+    for (size_t v = 0; v < graph.count_verts(); ++v)
+        count_discovered += workspace.is_visited(v);
+    EXPECT_LT(count_discovered, count_visited);
+
+    auto first = graph::bfs_range(graph, {graph, 0}) | std::views::take(3)
+                                                      | std::views::transform([](auto step) { return step.vertex; });
+    std::vector<uint32_t> first_vertexes;
+    for (auto vertex : first)
+        first_vertexes.push_back(vertex);
+    std::vector<int> bfs_order;
+    do_bfs(graph, {graph, 0}, create_path, bfs_order);
+    EXPECT_EQ(std::vector<uint32_t>(bfs_order.begin(), bfs_order.begin() + 3), first_vertexes);
+}
+
+TEST(Graph_multi_source_bfs, test_distances_eq_sequential) {
+    graph::graph_t<std::monostate, int, uint32_t> graph;
+    graph.read(generate_random_graph(2000, 2500, 1));
+    auto csr = graph::to_csr(graph);
+
+    std::mt19937 gen{1};
+    std::vector<uint32_t> sources(150);
+    for (auto& source : sources)
+        source = std::uniform_int_distribution<uint32_t>(0, graph.count_verts() - 1)(gen);
+
+    auto result1 = graph::do_multi_source_bfs(graph, sources);
+    auto result2 = graph::do_multi_source_bfs<2>(csr, sources);
+    auto result3 = graph::do_multi_source_bfs<4>(graph, sources, false);
+    EXPECT_TRUE(result3.distances.empty());
+
+    for (size_t i = 0; i < sources.size(); ++i) {
+        std::vector<size_t> levels = get_bfs_levels(graph, sources[i]);
+        for (size_t v = 0; v < graph.count_verts(); ++v) {
+            bool is_reachable = (levels[v] != std::numeric_limits<size_t>::max());
+            uint32_t expected = is_reachable ? levels[v] : result1.NOT_REACHED;
+            ASSERT_EQ(expected, result1.distance(i, v)) << "source " << i << ", vertex " << v << '\n';
+            ASSERT_EQ(expected, result2.distance(i, v)) << "source " << i << ", vertex " << v << '\n';
+            ASSERT_EQ(is_reachable, result1.is_reachable(i, v));
+            ASSERT_EQ(is_reachable, result3.is_reachable(i, v));
+        }
+    }
+}
+
+TEST(Graph_reorder, test_relabeled_eq_original) {
+    std::string file{__FILE__};
+    std::filesystem::path dir = file.substr(0, file.rfind('/'));
+
+    std::vector<std::string> inputs;
+    for (auto& test : get_sorted_files(dir / "../end_to_end/tests_in/")) {
+        std::ifstream test_file(test);
+        inputs.emplace_back(std::istreambuf_iterator<char>{test_file}, std::istreambuf_iterator<char>{});
+    }
+    inputs.push_back(generate_random_tree(20000, 1));
+    inputs.push_back(generate_random_graph(20000, 10000, 2));
+
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        graph::graph_t<std::monostate, int, uint32_t> original;
+        original.read(inputs[i]);
+        auto expected = get_bipartite(original);
+        auto original_children = get_sorted_children(original);
+
+        for (auto strategy : {graph::reorder_t::bfs, graph::reorder_t::rcm, graph::reorder_t::degree}) {
+            auto graph = original;
+            graph::reorder(graph, strategy);
+
+            auto children = get_sorted_children(graph);
+            for (size_t v = 0; v < graph.count_verts(); ++v) {
+                std::vector<size_t> mapped;
+                for (auto child : children[graph.internal_id(v)])
+                    mapped.push_back(graph.original_id(child));
+                std::sort(mapped.begin(), mapped.end());
+                ASSERT_EQ(original_children[v], mapped) << "in test : " << i + 1 << ", vertex " << v << '\n';
+            }
+
+            auto csr = graph::to_csr(graph);
+            EXPECT_TRUE(csr.is_relabeled());
+            for (auto&& result : {get_bipartite(graph), graph::get_parallel_bipartite(graph, 2), get_bipartite(csr)}) {
+                ASSERT_EQ(expected.is_bipartite, result.is_bipartite) << "in test : " << i + 1 << '\n';
+                if (expected.is_bipartite) {
+                    EXPECT_EQ(expected.colors, result.colors) << "in test : " << i + 1 << '\n';
+                } else {
+                    EXPECT_TRUE(is_odd_cycle(original, result.cycle)) << "in test : " << i + 1 << '\n';
+                }
+            }
+        }
+    }
+}
+
+TEST(Graph_stats, test_counters) {
+#ifdef GRAPH_STATS
+    using graph::stats::counter_t;
+    auto& stats = graph::stats::registry_t::instance();
+    stats.reset();
+    stats.set_enabled(true);
+
+    std::string input = generate_random_tree(1000, 1);
+    graph::graph_t<std::monostate, int> graph;
+    graph.read(input, 0, 1);
+    EXPECT_EQ(999, stats.get(counter_t::edges_parsed));
+    EXPECT_EQ(input.size(), stats.get(counter_t::bytes_read));
+
+    auto result = get_bipartite(graph);
+    EXPECT_TRUE(result.is_bipartite);
+    EXPECT_EQ(graph.count_verts(), stats.get(counter_t::vertexes_visited));
+    EXPECT_LT(stats.get(counter_t::queue_high_water), graph.count_verts());
+
+    std::ostringstream json;
+    stats.write_json(json);
+    for (auto key : {"\"parse\":", "\"create\":", "\"get_bipartite\":", "\"edges_parsed\":999"})
+        EXPECT_NE(json.str().find(key), std::string::npos) << key << " in " << json.str() << '\n';
+
+    /* queue holds all leaves of a star at once, one vertex of a path */
+    std::string star, path;
+    for (int v = 2; v <= 100; ++v) {
+        star += "1 -- " + std::to_string(v) + ", 1\n";
+        path += std::to_string(v - 1) + " -- " + std::to_string(v) + ", 1\n";
+    }
+    for (auto [edges, expected] : {std::pair{star, 99}, std::pair{path, 1}}) {
+        graph::graph_t<std::monostate, int> shaped;
+        shaped.read(edges);
+        for (bool is_bfs : {false, true}) {
+            stats.reset();
+            if (is_bfs)
+                do_bfs(shaped, {shaped, 0}, [](size_t) {});
+            else
+                get_bipartite(shaped);
+            EXPECT_EQ(expected, stats.get(counter_t::queue_high_water)) << (is_bfs ? "do_bfs\n" : "get_bipartite\n");
+        }
+    }
+
+    stats.reset();
+    stats.set_enabled(false);
+    get_bipartite(graph);
+    EXPECT_EQ(0, stats.get(counter_t::vertexes_visited));
+    EXPECT_EQ(0, stats.get_phase_ms("get_bipartite"));
+#else
+    GTEST_SKIP() << "built without GRAPH_STATS";
+#endif
+}
+
+TEST(Graph_writer, test_eq_ostream) {
+    std::FILE* file = std::tmpfile();
+    ASSERT_NE(file, nullptr);
+
+    std::ostringstream expected;
+    {
+        graph::buffered_writer_t writer{fileno(file)};
+        for (size_t v = 0; v < 100000; ++v) {
+            writer.write_number(v + 1);
+            writer.write(v % 3 ? " r " : " b ");
+            expected << v + 1 << (v % 3 ? " r " : " b ");
+        }
+        writer.write_number(-42);
+        writer.write(std::string(100000, 'x'));
+        writer.put('\n');
+        expected << -42 << std::string(100000, 'x') << '\n';
+    }
+
+    std::string written(expected.str().size() + 1, '\0');
+    std::rewind(file);
+    written.resize(std::fread(written.data(), 1, written.size(), file));
+    std::fclose(file);
+    EXPECT_EQ(expected.str(), written);
+}
+
+class counting_resource_t final : public std::pmr::memory_resource {
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        allocated += bytes;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* ptr, size_t bytes, size_t alignment) override {
+        std::pmr::new_delete_resource()->deallocate(ptr, bytes, alignment);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+public:
+    size_t allocated = 0;
+};
+
+TEST(Graph_memory, test_pmr_eq_default) {
+    std::string input = generate_random_graph(3000, 2000, 1);
+    graph::graph_t<std::monostate, int, uint32_t> expected;
+    expected.read(input);
+
+    counting_resource_t counting;
+    std::pmr::monotonic_buffer_resource arena{&counting};
+    graph::hugepage_resource_t hugepages{4096, &arena};
+
+    for (std::pmr::memory_resource* resource : {static_cast<std::pmr::memory_resource*>(&arena),
+                                                static_cast<std::pmr::memory_resource*>(&hugepages)}) {
+        graph::pmr_graph_t<std::monostate, int, uint32_t> graph{resource};
+        graph.read(input);
+        EXPECT_EQ(graph.get_allocator().resource(), resource);
+        EXPECT_EQ(get_sorted_children(expected), get_sorted_children(graph));
+
+        graph::traversal_workspace_t<uint32_t> workspace{resource};
+        auto result = get_bipartite(graph, workspace);
+        EXPECT_EQ(get_bipartite(expected).cycle, result.cycle);
+
+        size_t edge = graph.add_edge(0, 1);
+        graph.remove_edge(edge);
+        graph.compact();
+        graph::reorder(graph, graph::reorder_t::rcm);
+        EXPECT_EQ(expected.count_edges(), graph.count_edges());
+
+        decltype(graph) copy(graph, graph.get_allocator());
+        EXPECT_EQ(copy.get_allocator().resource(), resource);
+        EXPECT_EQ(graph::to_csr(graph).get_allocator().resource(), resource);
+        EXPECT_EQ(get_sorted_children(graph), get_sorted_children(copy));
+    }
+    EXPECT_GT(counting.allocated, 0);
+}
+
+TEST(Graph_monostate, test_index_only_iterators) {
+    using graph_type = graph::graph_t<std::monostate, std::monostate, uint32_t>;
+    using data_type = decltype(*std::declval<graph_type::const_iterator_t>());
+    static_assert(sizeof(data_type) == sizeof(uint32_t));
+    static_assert(sizeof(graph_type) < sizeof(graph::graph_t<int, int, uint32_t>));
+
+    std::string unweighted;
+    std::istringstream lines{generate_random_graph(2000, 3000, 1)};
+    for (std::string line; std::getline(lines, line);)
+        unweighted += line.substr(0, line.find(',')) + '\n';
+
+    graph_type graph;
+    graph.read(unweighted);
+    graph::graph_t<std::monostate, int, uint32_t> weighted;
+    weighted.read(generate_random_graph(2000, 3000, 1));
+    EXPECT_EQ(get_sorted_children(weighted), get_sorted_children(graph));
+
+    temp_file_t snapshot_file_guard{"graph_unit_test_monostate.snap"};
+    {
+        std::ofstream snapshot_file(snapshot_file_guard.path(), std::ios::binary);
+        graph.write_snapshot(snapshot_file);
+    }
+    graph::graph_snapshot_t<std::monostate, std::monostate, uint32_t> snapshot{snapshot_file_guard.path()};
+    EXPECT_EQ(get_sorted_children(graph), get_sorted_children(snapshot));
+}
+
+std::string generate_weighted_graph(size_t count_verts, size_t count_edges, int max_weight, unsigned seed) {
+    std::mt19937 gen{seed};
+    std::uniform_int_distribution<size_t> vertex(1, count_verts);
+    std::uniform_int_distribution<int> weight(0, max_weight);
+
+    std::string input;
+    for (size_t i = 0; i < count_edges; ++i) {
+        std::string edge = std::to_string(vertex(gen)) + " -- " + std::to_string(vertex(gen));
+        input += edge + ", " + std::to_string(weight(gen)) + "\n";
+    }
+    return input;
+}
+
+template <typename GraphT>
+std::vector<uint64_t> get_dijkstra_distances(const GraphT& graph, size_t start) {
+    std::vector<uint64_t> distances(graph.count_verts(), std::numeric_limits<uint64_t>::max());
+    using item_t = std::pair<uint64_t, size_t>;
+    std::priority_queue<item_t, std::vector<item_t>, std::greater<item_t>> q;
+    distances[start] = 0;
+    q.emplace(0, start);
+    while (!q.empty()) {
+        auto [distance, v] = q.top();
+        q.pop();
+        if (distance != distances[v])
+            continue;
+        for (auto child : graph.get_range_children({graph, v})) {
+            uint64_t next_distance = distance + child.edge();
+            if (next_distance < distances[child.index()]) {
+                distances[child.index()] = next_distance;
+                q.emplace(next_distance, child.index());
+            }
+        }
+    }
+    return distances;
+}
+
+template <typename GraphT, typename ResultT>
+void check_predecessor_tree(const GraphT& graph, size_t start, const ResultT& result) {
+    for (size_t v = 0; v < graph.count_verts(); ++v) {
+        if (!result.is_reachable(v) || v == start) {
+            EXPECT_EQ(v == start ? start : result.NO_PARENT, result.parents[v]);
+            continue;
+        }
+
+        size_t parent = result.parents[v];
+        bool has_edge = false;
+        for (auto child : graph.get_range_children({graph, parent}))
+            has_edge |= (child.index() == v && result.distances[parent] + child.edge() == result.distances[v]);
+        ASSERT_TRUE(has_edge) << "vertex " << v << '\n';
+    }
+}
+
+TEST(Graph_shortest_paths, test_distances_eq_dijkstra) {
+    std::vector<std::string> inputs{generate_weighted_graph(3000, 10000, 100, 1),
+                                    generate_weighted_graph(5000, 4000, 1000000, 2),
+                                    generate_weighted_graph(2000, 20000, 3, 3)};
+    for (auto& input : inputs) {
+        graph::graph_t<std::monostate, int, uint32_t> graph;
+        graph.read(input);
+        auto csr = graph::to_csr(graph);
+
+        for (size_t start : {size_t{0}, graph.count_verts() / 2}) {
+            std::vector<uint64_t> expected = get_dijkstra_distances(graph, start);
+            typename decltype(graph)::const_iterator_t iter{graph, start};
+            auto result1 = graph::get_shortest_paths(graph, iter);
+            auto result2 = graph::get_parallel_shortest_paths(graph, iter, 0, 4);
+            auto result3 = graph::get_parallel_shortest_paths(csr, {csr, start}, 7, 3);
+            assert_vectors_eq(expected, result1.distances);
+            assert_vectors_eq(expected, result2.distances);
+            assert_vectors_eq(expected, result3.distances);
+            check_predecessor_tree(graph, start, result1);
+            check_predecessor_tree(graph, start, result2);
+            check_predecessor_tree(csr,   start, result3);
+
+            std::vector<uint32_t> path = result2.get_path(graph.count_verts() - 1);
+            if (!path.empty()) {
+                EXPECT_EQ(start, path.front());
+                EXPECT_EQ(graph.count_verts() - 1, path.back());
+            }
+        }
+    }
+
+    /* delta of 1 for weights near INT_MAX would need 2^31 buckets per thread */
+    graph::graph_t<std::monostate, int, uint32_t> heavy;
+    heavy.read("1 -- 2, 2147483647\n2 -- 3, 1\n1 -- 3, 2147483000\n3 -- 4, 5\n");
+    graph::delta_stepping_t<decltype(heavy)> delta_stepping{heavy, 1, 2};
+    delta_stepping.run(0);
+    assert_vectors_eq(get_dijkstra_distances(heavy, 0), delta_stepping.result().distances);
+    EXPECT_GT(delta_stepping.delta(), 1U);
+
+    graph::graph_t<std::monostate, int> negative;
+    negative.read("1 -- 2, 3\n2 -- 3, -1\n");
+    EXPECT_THROW(graph::get_shortest_paths(negative, {negative, 0}), graph::error_t);
+    EXPECT_THROW(graph::get_parallel_shortest_paths(negative, {negative, 0}, 0, 2), graph::error_t);
+}
+
+TEST(Graph_spanning_forest, test_parallel_eq_kruskal) {
+    graph::graph_t<std::monostate, int> small;
+    small.read("1 -- 2, 4\n2 -- 3, 1\n1 -- 3, 2\n3 -- 3, -5\n4 -- 5, -1\n4 -- 5, 3\n");
+    auto small_result = graph::get_spanning_forest(small);
+    EXPECT_EQ(3, small_result.edges.size());
+    EXPECT_EQ(2, small_result.weight);
+
+    std::vector<std::string> inputs{generate_weighted_graph(3000, 10000, 100, 1),
+                                    generate_weighted_graph(20000, 15000, 1000000, 2),
+                                    generate_weighted_graph(2000, 20000, 3, 3)};
+    for (auto& input : inputs) {
+        graph::graph_t<std::monostate, int, uint32_t> graph;
+        graph.read(input);
+        for (size_t e = 0; e < graph.count_edge_slots(); e += 7)
+            graph.remove_edge(e);
+
+        auto expected = graph::get_spanning_forest(graph);
+        auto result = graph::get_parallel_spanning_forest(graph, 4);
+        EXPECT_EQ(expected.edges, result.edges);
+        EXPECT_EQ(expected.weight, result.weight);
+
+        graph::parity_union_find_t<uint32_t> forest{graph.count_verts()};
+        for (auto edge_index : result.edges) {
+            ASSERT_FALSE(graph.is_edge_removed(edge_index));
+            auto [v1, v2] = graph.get_edge_verts(edge_index);
+            ASSERT_EQ(forest.unite(v1, v2, false), graph::parity_union_find_t<uint32_t>::unite_status_t::joined);
+        }
+
+        graph::concurrent_union_find_t<uint32_t> components{graph.count_verts()};
+        for (size_t e = 0; e < graph.count_edge_slots(); ++e) {
+            if (!graph.is_edge_removed(e)) {
+                auto [v1, v2] = graph.get_edge_verts(e);
+                components.unite(v1, v2);
+            }
+        }
+        size_t count_components = 0;
+        for (uint32_t v = 0; v < graph.count_verts(); ++v)
+            count_components += (components.find(v) == v);
+        EXPECT_EQ(graph.count_verts() - count_components, result.edges.size());
+    }
+}
+
+std::string generate_bipartite_graph(size_t count_left, size_t count_right, size_t count_edges, unsigned seed) {
+    std::mt19937 gen{seed};
+    std::uniform_int_distribution<size_t> left(1, count_left), right(count_left + 1, count_left + count_right);
+
+    std::string input;
+    for (size_t i = 0; i < count_edges; ++i)
+        input += std::to_string(left(gen)) + " -- " + std::to_string(right(gen)) + ", 1\n";
+    return input;
+}
+
+/* Kuhn: augmenting path from every vertex of color 0 */
+template <typename GraphT>
+size_t get_kuhn_matching_size(const GraphT& graph, const std::vector<int>& colors) {
+    size_t count_verts = graph.count_verts();
+    std::vector<size_t> mates(count_verts, count_verts);
+    std::vector<bool> is_used;
+    std::function<bool(size_t)> try_augment = [&](size_t v) {
+        for (auto child : graph.get_range_children({graph, v})) {
+            size_t next = child.index();
+            if (is_used[next])
+                continue;
+            is_used[next] = true;
+            if (mates[next] == count_verts || try_augment(mates[next])) {
+                mates[next] = v;
+                return true;
+            }
+        }
+        return false;
+    };
+
+    size_t size = 0;
+    for (size_t v = 0; v < count_verts; ++v) {
+        if (colors[v] == 0) {
+            is_used.assign(count_verts, false);
+            size += try_augment(v);
+        }
+    }
+    return size;
+}
+
+TEST(Graph_matching, test_size_eq_kuhn) {
+    std::vector<std::string> inputs{generate_bipartite_graph(1000, 1000, 1500, 1),
+                                    generate_bipartite_graph(500, 2000, 4000, 2),
+                                    generate_bipartite_graph(3000, 1000, 2500, 3)};
+    for (auto& input : inputs) {
+        graph::graph_t<std::monostate, int, uint32_t> graph;
+        graph.read(input);
+        auto bipartite = graph::get_bipartite(graph);
+        ASSERT_TRUE(bipartite.is_bipartite);
+        size_t expected = get_kuhn_matching_size(graph, bipartite.colors);
+
+        graph::graph_t<std::monostate, int, uint32_t> relabeled;
+        relabeled.read(input);
+        graph::reorder(relabeled, graph::reorder_t::degree);
+
+        for (unsigned count_threads : {1U, 3U}) {
+            auto result1 = graph::get_maximum_matching(graph, bipartite, count_threads);
+            auto result2 = graph::get_maximum_matching(relabeled, graph::get_bipartite(relabeled), count_threads);
+            EXPECT_EQ(expected, result1.size);
+            EXPECT_EQ(expected, result2.size);
+
+            auto children = get_sorted_children(graph);
+            size_t count_matched = 0;
+            for (size_t v = 0; v < graph.count_verts(); ++v) {
+                if (!result2.is_matched(v))
+                    continue;
+                count_matched++;
+                uint32_t mate = result2.mates[v];
+                ASSERT_EQ(v, result2.mates[mate]);
+                ASSERT_TRUE(std::ranges::binary_search(children[v], mate));
+            }
+            EXPECT_EQ(2 * expected, count_matched);
+        }
+    }
+
+    graph::graph_t<std::monostate, int> triangle;
+    triangle.read("1 -- 2, 1\n2 -- 3, 1\n3 -- 1, 1\n");
+    EXPECT_THROW(graph::get_maximum_matching(triangle, graph::get_bipartite(triangle)), graph::error_t);
+}
+
+TEST(Graph_components, test_parallel_eq_bfs) {
+    std::vector<std::string> inputs{generate_random_graph(20000, 12000, 1),
+                                    generate_random_tree(30000, 2) + generate_random_graph(40000, 100, 3),
+                                    generate_random_graph(1000, 20000, 4)};
+    for (auto& input : inputs) {
+        graph::graph_t<std::monostate, int, uint32_t> graph;
+        graph.read(input);
+        graph::graph_t<std::monostate, int, uint32_t> relabeled;
+        relabeled.read(input);
+        graph::reorder(relabeled, graph::reorder_t::rcm);
+
+        auto expected = graph::get_connected_components(graph);
+        EXPECT_EQ(0, expected.labels[0]);
+        uint32_t total_size = 0;
+        for (auto size : expected.sizes)
+            total_size += size;
+        EXPECT_EQ(graph.count_verts(), total_size);
+
+        std::vector<size_t> levels = get_bfs_levels(graph, 0);
+        for (size_t v = 0; v < graph.count_verts(); ++v)
+            ASSERT_EQ(levels[v] != std::numeric_limits<size_t>::max(), expected.labels[v] == 0);
+
+        for (auto result : {graph::get_parallel_connected_components(graph, 4),
+                            graph::get_connected_components(relabeled),
+                            graph::get_parallel_connected_components(relabeled, 3)}) {
+            EXPECT_EQ(expected.labels, result.labels);
+            EXPECT_EQ(expected.sizes,  result.sizes);
+        }
+    }
+}
+
+TEST(Graph_external, test_external_eq_graph) {
+    std::vector<std::string> inputs{generate_weighted_graph(3000, 10000, 100, 1),
+                                    generate_random_tree(20001, 2),
+                                    generate_random_tree(5000, 3) + "1 -- 1, 7\n"};
+    temp_file_t file{"graph_unit_test.ext"};
+    const std::filesystem::path& path = file.path();
+    for (auto& input : inputs) {
+        graph::graph_t<std::monostate, int, uint32_t> graph;
+        graph.read(input);
+        graph::write_external_graph<int, uint32_t>(input, path);
+        graph::external_graph_t<std::monostate, int, uint32_t> external{path};
+
+        ASSERT_EQ(graph.count_verts(), external.count_verts());
+        ASSERT_EQ(graph.count_edges(), external.count_edges());
+        EXPECT_EQ(get_sorted_children(graph), get_sorted_children(external));
+        for (size_t v = 0; v < graph.count_verts(); v += 97) {
+            std::vector<std::pair<size_t, int>> expected, actual;
+            for (auto child : graph.get_range_children({graph, v}))
+                expected.emplace_back(child.index(), child.edge());
+            for (auto child : external.get_range_children({external, v}))
+                actual.emplace_back(child.index(), child.edge());
+            std::ranges::sort(expected);
+            std::ranges::sort(actual);
+            ASSERT_EQ(expected, actual) << "vertex " << v << '\n';
+        }
+
+        graph::io_usage_t before = graph::get_io_usage();
+        auto expected = graph::get_bipartite(graph);
+        auto result = graph::get_bipartite(external);
+        EXPECT_EQ(expected.is_bipartite, result.is_bipartite);
+        if (expected.is_bipartite) {
+            EXPECT_EQ(expected.colors, result.colors);
+        } else {
+            EXPECT_TRUE(is_odd_cycle(graph, result.cycle));
+        }
+        graph::io_usage_t usage = graph::get_io_usage() - before;
+        EXPECT_LE(usage.read_bytes, std::filesystem::file_size(path) + (1 << 20));
+
+        external.advise(MADV_SEQUENTIAL);
+        size_t count_visited = 0;
+        graph::do_bfs(external, {external, 0}, [&](size_t) { count_visited++; });
+        std::vector<size_t> levels = get_bfs_levels(graph, 0);
+        EXPECT_EQ(levels.size() - std::ranges::count(levels, std::numeric_limits<size_t>::max()), count_visited);
+    }
+
+    /* corrupted offsets and neighbors are rejected at load time */
+    graph::write_external_graph<int, uint32_t>(inputs[0], path);
+    auto header_size = graph::external_header_t::align(sizeof(graph::external_header_t));
+    auto corrupt = [&](uint64_t position, uint32_t value) {
+        std::fstream file{path, std::ios::in | std::ios::out | std::ios::binary};
+        file.seekp(static_cast<std::streamoff>(position));
+        file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    };
+    corrupt(header_size + 2 * sizeof(uint32_t), 0);
+    using external_type = graph::external_graph_t<std::monostate, int, uint32_t>;
+    EXPECT_THROW(external_type{path}, graph::error_t);
+
+    graph::write_external_graph<int, uint32_t>(inputs[0], path);
+    auto header = graph::external_header_t::create<int, uint32_t>(3000, 10000);
+    corrupt(header.neighbors_offset + 4 * sizeof(uint32_t), 1'000'000);
+    EXPECT_THROW(external_type{path}, graph::error_t);
+    EXPECT_NO_THROW((external_type{path, MADV_RANDOM, true}));
 }
 
 int main(int argc, char **argv) {